@@ -0,0 +1,103 @@
+//
+//  allocation_counter.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_ALLOCATION_COUNTER_H
+#define DM_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace dm
+{
+  /* heap allocations made through operator new */
+  struct allocation_count
+  {
+    std::uint64_t allocations;
+    std::uint64_t bytes;
+  };
+
+  /* whether operator new is counting, i.e. DM_COUNT_ALLOCATIONS is defined */
+#ifdef DM_COUNT_ALLOCATIONS
+  const bool allocations_counted = true;
+#else
+  const bool allocations_counted = false;
+#endif
+
+  /* the allocations of the calling thread so far, all zero unless counting */
+  inline allocation_count& thread_allocations()
+  {
+    static thread_local allocation_count count = { 0, 0 };
+    return count;
+  }
+
+  /* the allocations of the calling thread since construction */
+  class allocation_scope
+  {
+  public:
+    allocation_scope(): start_(thread_allocations())
+    {
+    }
+
+    std::uint64_t allocations() const
+    {
+      return thread_allocations().allocations - start_.allocations;
+    }
+
+    std::uint64_t bytes() const
+    {
+      return thread_allocations().bytes - start_.bytes;
+    }
+
+  private:
+    allocation_count start_;
+  };
+}
+
+/* with DM_COUNT_ALLOCATIONS, the global operator new is replaced to count, so include this in one translation unit only */
+#ifdef DM_COUNT_ALLOCATIONS
+
+void* operator new(std::size_t size)
+{
+  auto& count = dm::thread_allocations();
+  ++count.allocations;
+  count.bytes += size;
+  if (void* allocated = std::malloc(size ? size : 1))
+    return allocated;
+  throw std::bad_alloc();
+}
+
+/* out of line, so the compiler doesn't pair free with the operator new it sees */
+__attribute__((noinline)) void operator delete(void* allocated) noexcept
+{
+  std::free(allocated);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,713 @@
+//
+//  bench.cpp
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+//  bench: measures the encoder over the test words, generated surnames and optionally a file of words, one per line.
+//
+//    bench interleaved [WORDS]  words per second encoding one word at a time and 2, 4 and 8 words interleaved
+//    bench counters             time and Linux perf counters per word, by input letter, word length and ASCII against UTF-8
+//    bench latency [THREADS]    per call latency percentiles and allocations of the pair, callback and packed overloads,
+//                               by word length, with warm and cold caches and on many threads at once
+//    bench bounds [MEGABYTES]   time and allocations of one call on adversarial words up to MEGABYTES long, unlimited
+//                               and within encode_limits, failing if the limited calls grow with the word
+//    bench reference [WORDS]    words per second against a reference implementation, and where their keys differ
+//
+//  Allocations are counted when built with -DDM_COUNT_ALLOCATIONS. The reference mode needs -DDM_REFERENCE naming a header
+//  that defines reference_double_metaphone, see bench_reference.h.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "allocation_counter.h"
+#include "double_metaphone_interleaved.h"
+#include "latency_histogram.h"
+#include "test_words.h"
+
+#ifdef DM_REFERENCE
+#include DM_REFERENCE
+#endif
+
+namespace
+{
+  /* keeps results the compiler would otherwise drop */
+  volatile dm::packed_key sink;
+
+  struct corpus
+  {
+    std::string name;
+    std::vector<std::string> words;
+  };
+
+  /* the test words repeated to around count */
+  corpus test_corpus(std::size_t count)
+  {
+    corpus result { "test words", std::vector<std::string>() };
+    const std::size_t tests_count = sizeof(tests) / sizeof(tests[0]);
+    for (std::size_t i = 0; i < count; ++i)
+      result.words.push_back(tests[i % tests_count][0]);
+    return result;
+  }
+
+  /* surnames strung together from syllables of several languages, capitalized */
+  corpus surname_corpus(std::size_t count)
+  {
+    static const char* syllables[] = {
+      "ab", "al", "an", "bach", "bar", "ber", "bri", "cia", "chen", "der", "don", "ek", "el", "er", "ez", "gar",
+      "ger", "ham", "hof", "ja", "ka", "kow", "ler", "li", "lo", "ma", "mann", "mc", "mid", "mond", "ner", "nes",
+      "ni", "o", "ov", "pez", "phi", "quez", "ri", "rich", "sch", "sen", "ski", "son", "ste", "ti", "ton", "tz",
+      "van", "vich", "wa", "wit", "ya", "zh", "zu"
+    };
+    const std::size_t syllables_count = sizeof(syllables) / sizeof(syllables[0]);
+
+    corpus result { "generated surnames", std::vector<std::string>() };
+    std::uint32_t seed = 1;
+    auto random = [&seed]() { return (seed = seed * 1664525 + 1013904223) >> 8; };
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      std::string surname;
+      for (std::size_t parts = 2 + random() % 3; parts; --parts)
+        surname += syllables[random() % syllables_count];
+      surname[0] -= 0x20;
+      result.words.push_back(surname);
+    }
+    return result;
+  }
+
+  corpus file_corpus(const std::string& path)
+  {
+    std::ifstream words(path);
+    if (!words)
+      throw std::runtime_error("bench: can't read " + path);
+    corpus result { path, std::vector<std::string>() };
+    std::string word;
+    while (std::getline(words, word))
+      result.words.push_back(word);
+    return result;
+  }
+
+  std::vector<corpus> corpora(int argc, char** argv)
+  {
+    std::vector<corpus> result;
+    result.push_back(test_corpus(1000000));
+    result.push_back(surname_corpus(1000000));
+    if (argc > 2)
+      result.push_back(file_corpus(argv[2]));
+    return result;
+  }
+
+  /* best of several runs, in seconds */
+  template <typename F> double best_time(F run)
+  {
+    double best = 1e300;
+    for (int i = 0; i < 5; ++i)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      run();
+      best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+  }
+
+  int interleaved(int argc, char** argv)
+  {
+    for (auto& corpus : corpora(argc, argv))
+    {
+      const auto& words = corpus.words;
+      std::vector<dm::packed_keys> expected(words.size());
+      std::vector<dm::packed_keys> keys(words.size());
+
+      std::cout << corpus.name << ", " << words.size() << " words\n";
+      auto report = [&](const char* name, double seconds, bool check)
+      {
+        std::cout << "  " << std::left << std::setw(14) << name << std::right << std::fixed << std::setprecision(1)
+          << std::setw(8) << words.size() / seconds / 1e6 << " M words/s"
+          << (!check || keys == expected ? "" : ", MISMATCHED") << "\n";
+      };
+
+      report("one at a time", best_time([&]()
+                                        {
+                                          for (std::size_t i = 0; i < words.size(); ++i)
+                                            expected[i] = dm::double_metaphone_packed(words[i]);
+                                        }), false);
+      report("2 interleaved", best_time([&]() { dm::double_metaphone_packed_interleaved<2>(words.data(), words.size(), keys.data()); }), true);
+      report("4 interleaved", best_time([&]() { dm::double_metaphone_packed_interleaved<4>(words.data(), words.size(), keys.data()); }), true);
+      report("8 interleaved", best_time([&]() { dm::double_metaphone_packed_interleaved<8>(words.data(), words.size(), keys.data()); }), true);
+    }
+    return 0;
+  }
+
+  /* user space hardware counters of this thread through perf_event_open, any the machine, kernel or permissions
+     don't allow left unavailable, e.g. in most virtual machines or with perf_event_paranoid above 2,
+     and all of them unavailable off Linux */
+  class perf_counters
+  {
+  public:
+    enum counter
+    {
+      cycles,
+      instructions,
+      branch_misses,
+      cache_misses,
+      counters
+    };
+
+    perf_counters()
+    {
+#ifdef __linux__
+      const std::uint64_t configs[counters] =
+      {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_BRANCH_MISSES,
+        PERF_COUNT_HW_CACHE_MISSES
+      };
+      for (int which = 0; which < counters; ++which)
+      {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[which];
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        files_[which] = int(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+        values_[which] = 0;
+      }
+#else
+      for (int which = 0; which < counters; ++which)
+      {
+        files_[which] = -1;
+        values_[which] = 0;
+      }
+#endif
+    }
+
+    perf_counters(const perf_counters&) = delete;
+    perf_counters& operator=(const perf_counters&) = delete;
+
+    ~perf_counters()
+    {
+#ifdef __linux__
+      for (int file : files_)
+        if (file >= 0)
+          ::close(file);
+#endif
+    }
+
+    bool available(counter which) const
+    {
+      return files_[which] >= 0;
+    }
+
+    void start()
+    {
+#ifdef __linux__
+      for (int file : files_)
+        if (file >= 0)
+        {
+          ::ioctl(file, PERF_EVENT_IOC_RESET, 0);
+          ::ioctl(file, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop()
+    {
+#ifdef __linux__
+      for (int which = 0; which < counters; ++which)
+        if (files_[which] >= 0)
+        {
+          ::ioctl(files_[which], PERF_EVENT_IOC_DISABLE, 0);
+
+          /* scaled up if the kernel multiplexed the counter */
+          std::uint64_t read[3];
+          values_[which] = ::read(files_[which], read, sizeof(read)) == sizeof(read) && read[2]
+            ? double(read[0]) * read[1] / read[2]
+            : 0;
+        }
+#endif
+    }
+
+    double value(counter which) const
+    {
+      return values_[which];
+    }
+
+  private:
+    int files_[counters];
+    double values_[counters];
+  };
+
+  /* random words of len letters; every other letter is letter if given, and a fifth of letters are 2 byte UTF-8 if utf8 */
+  std::vector<std::string> generated_words(std::size_t count, std::size_t len, char letter, bool utf8)
+  {
+    static const char* accented[] = { u8"Ç", u8"Ñ", u8"É", u8"Ü", u8"Ö", u8"À", u8"ç", u8"ñ", u8"é", u8"ü" };
+    std::uint32_t seed = std::uint32_t(len * 31 + letter + utf8);
+    auto random = [&seed]() { return (seed = seed * 1664525 + 1013904223) >> 8; };
+
+    std::vector<std::string> words(count);
+    for (auto& word : words)
+      for (std::size_t i = 0; i < len; ++i)
+        if (letter && i % 2 == 0)
+          word += letter;
+        else if (utf8 && random() % 5 == 0)
+          word += accented[random() % (sizeof(accented) / sizeof(accented[0]))];
+        else
+          word += char((random() % 2 ? 'A' : 'a') + random() % 26);
+    return words;
+  }
+
+  int counters(int, char**)
+  {
+    perf_counters perf;
+    if (!perf.available(perf_counters::cycles))
+      std::cout << "perf counters unavailable, timing only\n";
+
+    std::cout << std::left << std::setw(12) << "words" << std::right
+      << std::setw(10) << "ns" << std::setw(10) << "cycles" << std::setw(10) << "instrs"
+      << std::setw(10) << "IPC" << std::setw(10) << "br-miss" << std::setw(10) << "c-miss" << "  per word\n";
+
+    auto measure = [&perf](const std::string& name, const std::vector<std::string>& words)
+    {
+      dm::packed_key sum = 0;
+      for (auto& word : words)
+        sum += dm::double_metaphone_packed(word).first;
+
+      perf.start();
+      const auto start = std::chrono::steady_clock::now();
+      for (auto& word : words)
+        sum += dm::double_metaphone_packed(word).first;
+      const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      perf.stop();
+
+      const double count = double(words.size());
+      auto column = [&perf, count](perf_counters::counter which)
+      {
+        std::cout << std::setw(10);
+        if (perf.available(which))
+          std::cout << perf.value(which) / count;
+        else
+          std::cout << "-";
+      };
+      std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(1)
+        << std::setw(10) << seconds * 1e9 / count;
+      column(perf_counters::cycles);
+      column(perf_counters::instructions);
+      std::cout << std::setw(10) << std::setprecision(2);
+      if (perf.available(perf_counters::cycles) && perf.available(perf_counters::instructions) && perf.value(perf_counters::cycles))
+        std::cout << perf.value(perf_counters::instructions) / perf.value(perf_counters::cycles);
+      else
+        std::cout << "-";
+      column(perf_counters::branch_misses);
+      column(perf_counters::cache_misses);
+      std::cout << "\n";
+      sink = sum;
+    };
+
+    const std::size_t count = 200000;
+    for (char letter = 'A'; letter <= 'Z'; ++letter)
+      measure(std::string("letter ") + letter, generated_words(count, 8, letter, false));
+    for (std::size_t len = 1; len <= 64; len *= 2)
+      measure("length " + std::to_string(len), generated_words(count, len, 0, false));
+    measure("ASCII", generated_words(count, 8, 0, false));
+    measure("UTF-8", generated_words(count, 8, 0, true));
+    return 0;
+  }
+
+  /* per call latencies and allocations of one overload over some words */
+  struct latencies
+  {
+    dm::latency_histogram histogram;
+    std::uint64_t allocations = 0;
+    std::uint64_t allocated_bytes = 0;
+
+    void merge(const latencies& other)
+    {
+      histogram.merge(other.histogram);
+      allocations += other.allocations;
+      allocated_bytes += other.allocated_bytes;
+    }
+  };
+
+  /* evicts the words and encoder data from the private caches by writing a buffer twice the size of the last of them */
+  class cache_evictor
+  {
+  public:
+    cache_evictor(): buffer_(2 * cache_size())
+    {
+    }
+
+    void evict()
+    {
+      for (std::size_t i = 0; i < buffer_.size(); i += 64)
+        ++buffer_[i];
+    }
+
+  private:
+    static std::size_t cache_size()
+    {
+#if defined(__linux__) && defined(_SC_LEVEL2_CACHE_SIZE)
+      const long size = ::sysconf(_SC_LEVEL2_CACHE_SIZE);
+      if (size > 0)
+        return std::size_t(size);
+#endif
+      return std::size_t(4) << 20;
+    }
+
+    std::vector<char> buffer_;
+  };
+
+  /* times encode(word) on each word, in rounds, evicting the caches before each call if cold */
+  template <typename F> latencies time_calls(const std::vector<std::string>& words, std::size_t rounds, cache_evictor* cold, F encode)
+  {
+    latencies result;
+    for (std::size_t round = 0; round < rounds; ++round)
+      for (auto& word : words)
+      {
+        if (cold)
+          cold->evict();
+        const dm::allocation_scope allocations;
+        const auto start = std::chrono::steady_clock::now();
+        encode(word);
+        const auto finish = std::chrono::steady_clock::now();
+        result.histogram.record(std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count()));
+        result.allocations += allocations.allocations();
+        result.allocated_bytes += allocations.bytes();
+      }
+    return result;
+  }
+
+  int latency(int argc, char** argv)
+  {
+    const std::size_t threads = argc > 2 ? std::size_t(std::atoi(argv[2])) : std::max(4u, std::thread::hardware_concurrency());
+    if (threads == 0)
+      throw std::runtime_error("bench: bad thread count");
+
+    /* words of lengths from first up to last inclusive */
+    struct bucket
+    {
+      std::size_t first;
+      std::size_t last;
+      std::vector<std::string> words;
+    };
+    std::vector<bucket> buckets = { { 1, 4 }, { 5, 8 }, { 9, 16 }, { 17, 32 }, { 33, 64 } };
+    std::uint32_t seed = 1;
+    auto random = [&seed]() { return (seed = seed * 1664525 + 1013904223) >> 8; };
+    for (auto& bucket : buckets)
+      for (std::size_t i = 0; i < 1000; ++i)
+      {
+        std::string word;
+        for (std::size_t len = bucket.first + random() % (bucket.last - bucket.first + 1); len; --len)
+          word += char((random() % 2 ? 'A' : 'a') + random() % 26);
+        bucket.words.push_back(word);
+      }
+
+    /* the three overloads, each keeping its result */
+    typedef latencies (*timer)(const std::vector<std::string>&, std::size_t, cache_evictor*);
+    const std::pair<const char*, timer> overloads[] =
+    {
+      { "pair", [](const std::vector<std::string>& words, std::size_t rounds, cache_evictor* cold)
+        {
+          return time_calls(words, rounds, cold, [](const std::string& word) { sink = dm::double_metaphone(word).first.size(); });
+        } },
+      { "callback", [](const std::vector<std::string>& words, std::size_t rounds, cache_evictor* cold)
+        {
+          return time_calls(words, rounds, cold, [](const std::string& word)
+                            {
+                              std::size_t parts = 0;
+                              dm::double_metaphone(word, [&parts](const char*, const char*, size_t, size_t) { ++parts; });
+                              sink = parts;
+                            });
+        } },
+      { "packed", [](const std::vector<std::string>& words, std::size_t rounds, cache_evictor* cold)
+        {
+          return time_calls(words, rounds, cold, [](const std::string& word) { sink = dm::double_metaphone_packed(word).first; });
+        } }
+    };
+
+    std::cout << std::left << std::setw(10) << "overload" << std::setw(8) << "length" << std::setw(12) << "caches"
+      << std::right << std::setw(10) << "calls" << std::setw(8) << "p50" << std::setw(8) << "p99" << std::setw(8) << "p999"
+      << std::setw(10) << "max" << std::setw(10) << "allocs" << std::setw(10) << "bytes" << "  ns, per call\n";
+    auto report = [](const char* overload, const bucket& bucket, const std::string& caches, const latencies& measured)
+    {
+      const auto& histogram = measured.histogram;
+      std::cout << std::left << std::setw(10) << overload
+        << std::setw(8) << (std::to_string(bucket.first) + "-" + std::to_string(bucket.last)) << std::setw(12) << caches
+        << std::right << std::setw(10) << histogram.count()
+        << std::setw(8) << histogram.percentile(0.5) << std::setw(8) << histogram.percentile(0.99)
+        << std::setw(8) << histogram.percentile(0.999) << std::setw(10) << histogram.max()
+        << std::fixed << std::setprecision(2) << std::setw(10);
+      if (dm::allocations_counted)
+        std::cout << double(measured.allocations) / histogram.count()
+          << std::setprecision(1) << std::setw(10) << double(measured.allocated_bytes) / histogram.count() << "\n";
+      else
+        std::cout << "-" << std::setw(10) << "-" << "\n";
+    };
+
+    cache_evictor evictor;
+    for (auto& overload : overloads)
+      for (auto& bucket : buckets)
+      {
+        overload.second(bucket.words, 1, nullptr);
+        report(overload.first, bucket, "warm", overload.second(bucket.words, 100, nullptr));
+        report(overload.first, bucket, "cold", overload.second(bucket.words, 1, &evictor));
+
+        std::vector<latencies> measured(threads);
+        std::vector<std::thread> callers;
+        for (std::size_t thread = 0; thread < threads; ++thread)
+          callers.push_back(std::thread([&, thread]() { measured[thread] = overload.second(bucket.words, 100 / threads + 1, nullptr); }));
+        latencies merged;
+        for (std::size_t thread = 0; thread < threads; ++thread)
+        {
+          callers[thread].join();
+          merged.merge(measured[thread]);
+        }
+        report(overload.first, bucket, std::to_string(threads) + " threads", merged);
+      }
+    return 0;
+  }
+
+  /* one call on adversarial words of growing size, unlimited and within limits: the limited calls should take the same time
+     and memory at every size */
+  int bounds(int argc, char** argv)
+  {
+    const std::size_t megabytes = argc > 2 ? std::size_t(std::atoi(argv[2])) : 16;
+    if (megabytes == 0)
+      throw std::runtime_error("bench: bad size");
+    std::vector<std::size_t> sizes;
+    for (std::size_t size = 1 << 10; size < megabytes << 20; size <<= 3)
+      sizes.push_back(size);
+    sizes.push_back(megabytes << 20);
+
+    struct shape
+    {
+      const char* name;
+      const char* unit;
+    };
+    const shape shapes[] =
+    {
+      { "AJ run", "AJ" },          /* rules asking whether the word is slavo-germanic at every J */
+      { "SIO run", "SIO" },        /* likewise at every S */
+      { "vowels", "A" },           /* no symbols after the first, so packed keys never fill */
+      { "UTF-8", "\xc3\xb1" }      /* lowercase N tilde, uppercased a byte at a time */
+    };
+
+    const dm::encode_limits limits(256, 256);
+    typedef void (*encoder)(const std::string&, const dm::encode_limits*);
+    const std::pair<const char*, encoder> overloads[] =
+    {
+      { "pair", [](const std::string& word, const dm::encode_limits* limits)
+        {
+          sink = (limits ? dm::double_metaphone(word, *limits) : dm::double_metaphone(word)).first.size();
+        } },
+      { "packed", [](const std::string& word, const dm::encode_limits* limits)
+        {
+          sink = (limits ? dm::double_metaphone_packed(word.data(), word.size(), *limits) : dm::double_metaphone_packed(word.data(), word.size())).first;
+        } }
+    };
+
+    std::cout << std::left << std::setw(8) << "shape" << std::setw(10) << "bytes" << std::setw(16) << "overload"
+      << std::right << std::setw(14) << "ns" << std::setw(10) << "allocs" << std::setw(12) << "bytes" << "  per call\n";
+    int unbounded = 0;
+    for (auto& shape : shapes)
+      for (auto& overload : overloads)
+        for (auto limited : { false, true })
+        {
+          /* time and memory of the smallest word, to hold the larger ones to */
+          double first_time = 0;
+          std::uint64_t first_bytes = 0;
+          for (auto size : sizes)
+          {
+            std::string word;
+            while (word.size() < size)
+              word += shape.unit;
+
+            const double time = std::min(best_time([&]() { overload.second(word, limited ? &limits : nullptr); }), 1.0);
+            const dm::allocation_scope allocations;
+            overload.second(word, limited ? &limits : nullptr);
+
+            const std::string name = std::string(overload.first) + (limited ? " limited" : "");
+            std::cout << std::left << std::setw(8) << shape.name << std::setw(10) << size << std::setw(16) << name
+              << std::right << std::fixed << std::setprecision(0) << std::setw(14) << time * 1e9;
+            if (dm::allocations_counted)
+              std::cout << std::setw(10) << allocations.allocations() << std::setw(12) << allocations.bytes();
+            else
+              std::cout << std::setw(10) << "-" << std::setw(12) << "-";
+
+            if (size == sizes.front())
+            {
+              first_time = time;
+              first_bytes = allocations.bytes();
+            }
+            else if (limited && (time > 4 * first_time + 10e-6 || allocations.bytes() != first_bytes))
+            {
+              std::cout << "  UNBOUNDED";
+              ++unbounded;
+            }
+            std::cout << "\n";
+          }
+        }
+    return unbounded != 0;
+  }
+
+#ifdef DM_REFERENCE
+  /* how the keys of a word differ from the reference's: intended differences first */
+  enum difference
+  {
+    same,
+    truncated,  /* the reference stops at 4 symbols, we don't */
+    non_ascii,  /* we read UTF-8, the reference Latin-1 or nothing */
+    lowercase,  /* we uppercase ASCII and UTF-8 Latin-1 letters, the reference may expect uppercase */
+    other,
+    differences
+  };
+
+  difference classify(const std::string& word, const std::pair<std::string, std::string>& ours, const std::pair<std::string, std::string>& theirs)
+  {
+    /* only a reference key of exactly 4 symbols may have been cut short of ours */
+    auto truncated_key = [](const std::string& our_key, const std::string& their_key)
+    {
+      return their_key.size() == 4 ? our_key.compare(0, 4, their_key) == 0 : our_key == their_key;
+    };
+    auto truncated_same = [&](const std::pair<std::string, std::string>& keys)
+    {
+      return truncated_key(ours.first, keys.first) && truncated_key(ours.second, keys.second);
+    };
+
+    if (ours == theirs)
+      return same;
+    if (truncated_same(theirs))
+      return truncated;
+    for (char ch : word)
+      if (ch & 0x80)
+        return non_ascii;
+
+    std::string upper = word;
+    for (auto& ch : upper)
+      if (ch >= 'a' && ch <= 'z')
+        ch -= 0x20;
+    if (upper != word && truncated_same(reference_double_metaphone(upper)))
+      return lowercase;
+    return other;
+  }
+
+  int reference(int argc, char** argv)
+  {
+    const char* names[differences] = { "same", "same to 4 symbols", "non-ASCII", "lowercase", "other" };
+    for (auto& corpus : corpora(argc, argv))
+    {
+      const auto& words = corpus.words;
+      std::vector<std::pair<std::string, std::string>> ours(words.size());
+      std::vector<std::pair<std::string, std::string>> theirs(words.size());
+      const double our_time = best_time([&]()
+                                        {
+                                          for (std::size_t i = 0; i < words.size(); ++i)
+                                            ours[i] = dm::double_metaphone(words[i]);
+                                        });
+      const double their_time = best_time([&]()
+                                          {
+                                            for (std::size_t i = 0; i < words.size(); ++i)
+                                              theirs[i] = reference_double_metaphone(words[i]);
+                                          });
+
+      std::size_t counts[differences] = {};
+      std::vector<std::size_t> others;
+      for (std::size_t i = 0; i < words.size(); ++i)
+      {
+        const auto kind = classify(words[i], ours[i], theirs[i]);
+        ++counts[kind];
+        if (kind == other && others.size() < 20 && std::find_if(others.begin(), others.end(), [&](std::size_t j) { return words[j] == words[i]; }) == others.end())
+          others.push_back(i);
+      }
+
+      std::cout << corpus.name << ", " << words.size() << " words\n" << std::fixed << std::setprecision(1)
+        << "  ours " << words.size() / our_time / 1e6 << " M words/s, reference " << words.size() / their_time / 1e6
+        << " M words/s, " << std::setprecision(2) << their_time / our_time << "x\n";
+      for (int kind = 0; kind < differences; ++kind)
+        std::cout << "  " << std::left << std::setw(20) << names[kind] << std::right << std::setw(10) << counts[kind] << "\n";
+      for (auto i : others)
+        std::cout << "    " << words[i] << ": " << ours[i].first << " " << ours[i].second
+          << " against " << theirs[i].first << " " << theirs[i].second << "\n";
+    }
+    return 0;
+  }
+#else
+  int reference(int, char**)
+  {
+    throw std::runtime_error("bench: build with -DDM_REFERENCE='\"bench_reference.h\"' for this mode");
+  }
+#endif
+}
+
+int main(int argc, char** argv)
+{
+  try
+  {
+    const std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "interleaved" && argc <= 3)
+      return interleaved(argc, argv);
+    if (mode == "counters" && argc == 2)
+      return counters(argc, argv);
+    if (mode == "latency" && argc <= 3)
+      return latency(argc, argv);
+    if (mode == "bounds" && argc <= 3)
+      return bounds(argc, argv);
+    if (mode == "reference" && argc <= 3)
+      return reference(argc, argv);
+  }
+  catch (const std::exception& error)
+  {
+    std::cerr << error.what() << "\n";
+    return 1;
+  }
+
+  std::cerr << "usage: bench interleaved [WORDS]\n"
+    "       bench counters\n"
+    "       bench latency [THREADS]\n"
+    "       bench bounds [MEGABYTES]\n"
+    "       bench reference [WORDS]\n";
+  return 2;
+}
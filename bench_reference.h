@@ -0,0 +1,56 @@
+//
+//  bench_reference.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_BENCH_REFERENCE_H
+#define DM_BENCH_REFERENCE_H
+
+//  The reference Double Metaphone for bench reference: Lawrence Philips' original dmetaph.cpp and MString.h, vendored
+//  under reference/ with a stdafx.h that stands in for the MFC CString they build on. Only the bench includes it:
+//
+//    g++ -std=c++11 -O2 -pthread -DDM_REFERENCE='"bench_reference.h"' bench.cpp -obench && ./bench reference [WORDS]
+//
+//  Any other reference can stand in by defining reference_double_metaphone the same way.
+
+#include <string>
+#include <utility>
+
+#include "reference/dmetaph.cpp"
+
+inline std::pair<std::string, std::string> reference_double_metaphone(const std::string& word)
+{
+  MString input(word.c_str());
+  MString primary;
+  MString alternate;
+  input.DoubleMetaphone(primary, alternate);
+  /* the original leaves the alternate empty when it's the same as the primary */
+  const std::string first(static_cast<const char*>(primary));
+  const std::string second(static_cast<const char*>(alternate));
+  return std::make_pair(first, second.empty() ? first : second);
+}
+
+#endif
@@ -33,101 +33,74 @@
 #ifndef DM_DOUBLE_METAPHONE_H
 #define DM_DOUBLE_METAPHONE_H
 
+#include <cstddef>
 #include <string>
 #include <utility>
 
 namespace dm
 {
-  template <typename F> inline void double_metaphone(std::string str, F callback)
+  /* bounds on the work of encoding one word, so runaway input can't stall the caller */
+  struct encode_limits
   {
-    size_t current = 0;
+    /* bytes of the word read, cut back to a whole UTF-8 character */
+    std::size_t max_length;
 
-    /* we need the real length and last prior to padding */
-    const auto length = str.length();
-    const auto last = length - 1;
+    /* turns of the main loop, each taking 1 to 3 letters */
+    std::size_t max_steps;
 
-    auto IsVowel = [&](size_t at)
+    explicit encode_limits(std::size_t max_length = std::size_t(-1), std::size_t max_steps = std::size_t(-1)):
+      max_length(max_length),
+      max_steps(max_steps)
     {
-      if (at < length)
-        switch (str[at])
-      {
-        case 'A':
-        case 'E':
-        case 'I':
-        case 'O':
-        case 'U':
-        case 'Y':
-          return true;
-      }
-      return false;
-    };
-
-    auto SlavoGermanic = [&]()
-    {
-      return str.find_first_of("WK") != std::string::npos ||
-        str.find("CZ") != std::string::npos ||
-        str.find("WITZ") != std::string::npos;
-    };
-
-    auto StringAt = [&](size_t start, size_t len, std::initializer_list<const char*> sstrings)
-    {
-      if (start < length)
-      {
-        auto strStart = str.begin() + start;
-        auto strFinish = strStart + len;
-        for (auto sstring : sstrings)
-          if (std::equal(strStart, strFinish, sstring))
-            return true;
-      }
-      return false;
-    };
+    }
+  };
 
-    auto CharAt = [&](size_t start, std::initializer_list<char> cchars)
-    {
-      if (start < length)
-      {
-        auto ch = str[start];
-        for (auto cchar : cchars)
-          if (ch == cchar)
-            return true;
-      }
-      return false;
-    };
+  /* length of the longest prefix of at most max bytes not ending inside a UTF-8 character;
+     looks back no further than a character can be long, so invalid input is cut at max */
+  inline std::size_t utf8_prefix(const char* word, std::size_t size, std::size_t max)
+  {
+    if (size <= max)
+      return size;
+    for (std::size_t back = 0; back < 4 && back <= max; ++back)
+      if (back == max || (word[max - back] & 0xC0) != 0x80)
+        return max - back;
+    return max;
+  }
 
-    /* uppercase string */
-    bool other_latin_prefix = false;
-    for (auto& ch : str)
+  /* the state of encoding one word, advanced one group of letters at a time so several words can be interleaved */
+  class double_metaphone_encoder
+  {
+  public:
+    /* takes a word, calling back for any letters skipped or mapped at its start */
+    template <typename F> void start(std::string word, F& callback, const encode_limits& limits = encode_limits())
     {
-      if ((ch >= 'a' && ch <= 'z') ||
-          (other_latin_prefix && ch >= '\xa0' && ch <= '\xbe'))
-        ch -= 0x20;
-      other_latin_prefix = ch == '\xc3';
+      word.resize(utf8_prefix(word.data(), word.size(), limits.max_length));
+      str = std::move(word);
+      begin(callback, limits);
     }
 
-    /* pad original so we can index beyond end */
-    str.append(5, ' ');
-
-    /* skip these when at start of word */
-    if (StringAt(0, 2, {"GN", "KN", "PN", "WR", "PS"}))
+    /* copies no more of the word than the limits allow, into a buffer kept across words so it allocates only to grow */
+    template <typename F> void start(const char* word, std::size_t size, F& callback, const encode_limits& limits = encode_limits())
     {
-      callback(nullptr, nullptr, 0, 1);
-      ++current;
+      size = utf8_prefix(word, size, limits.max_length);
+      str.reserve(size + 5);
+      str.assign(word, size);
+      begin(callback, limits);
     }
 
-    /* Initial 'X' is pronounced 'Z' e.g. 'Xavier' */
-    if (str[0] == 'X')
+    bool done() const
     {
-      callback("S", "S", 0, 1); /* 'Z' maps to 'S' */
-      ++current;
+      return current >= length || !steps_left;
     }
 
-    /* main loop */
-    while (current < length)
+    /* one turn of the main loop, calling back for the next group of letters */
+    template <typename F> void step(F& callback)
     {
       const char* metaph1 = nullptr;
       const char* metaph2 = nullptr;
       int inc = 0;
 
+      --steps_left;
       switch (str[current])
       {
         case 'A':
@@ -1046,21 +1019,133 @@ namespace dm
       callback(metaph1, metaph2, current, inc);
       current += inc;
     }
+
+  private:
+    template <typename F> void begin(F& callback, const encode_limits& limits)
+    {
+      current = 0;
+      steps_left = limits.max_steps;
+
+      /* we need the real length and last prior to padding */
+      length = str.length();
+      last = length - 1;
+
+      /* uppercase string */
+      bool other_latin_prefix = false;
+      for (auto& ch : str)
+      {
+        if ((ch >= 'a' && ch <= 'z') ||
+            (other_latin_prefix && ch >= '\xa0' && ch <= '\xbe'))
+          ch -= 0x20;
+        other_latin_prefix = ch == '\xc3';
+      }
+
+      /* once per word rather than at every rule asking */
+      slavo_germanic = str.find_first_of("WK") != std::string::npos ||
+        str.find("CZ") != std::string::npos ||
+        str.find("WITZ") != std::string::npos;
+
+      /* pad original so we can index beyond end */
+      str.append(5, ' ');
+
+      /* skip these when at start of word */
+      if (StringAt(0, 2, {"GN", "KN", "PN", "WR", "PS"}))
+      {
+        callback(nullptr, nullptr, 0, 1);
+        ++current;
+      }
+
+      /* Initial 'X' is pronounced 'Z' e.g. 'Xavier' */
+      if (str[0] == 'X')
+      {
+        callback("S", "S", 0, 1); /* 'Z' maps to 'S' */
+        ++current;
+      }
+    }
+
+
+    bool IsVowel(size_t at) const
+    {
+      if (at < length)
+        switch (str[at])
+      {
+        case 'A':
+        case 'E':
+        case 'I':
+        case 'O':
+        case 'U':
+        case 'Y':
+          return true;
+      }
+      return false;
+    }
+
+    bool SlavoGermanic() const
+    {
+      return slavo_germanic;
+    }
+
+    bool StringAt(size_t start, size_t len, std::initializer_list<const char*> sstrings) const
+    {
+      if (start < length)
+      {
+        auto strStart = str.begin() + start;
+        auto strFinish = strStart + len;
+        for (auto sstring : sstrings)
+          if (std::equal(strStart, strFinish, sstring))
+            return true;
+      }
+      return false;
+    }
+
+    bool CharAt(size_t start, std::initializer_list<char> cchars) const
+    {
+      if (start < length)
+      {
+        auto ch = str[start];
+        for (auto cchar : cchars)
+          if (ch == cchar)
+            return true;
+      }
+      return false;
+    }
+
+    std::string str;
+    size_t current;
+    size_t length;
+    size_t last;
+    size_t steps_left;
+    bool slavo_germanic;
+  };
+
+  /* reads the word in place, copying only as much as the limits allow, once and with room for the padding */
+  template <typename F> inline void double_metaphone(const char* word, size_t size, F callback, const encode_limits& limits = encode_limits())
+  {
+    double_metaphone_encoder encoder;
+    encoder.start(word, size, callback, limits);
+    while (!encoder.done())
+      encoder.step(callback);
+  }
+
+  template <typename F> inline void double_metaphone(const std::string& str, F callback, const encode_limits& limits = encode_limits())
+  {
+    double_metaphone(str.data(), str.size(), callback, limits);
   }
 
-  inline std::pair<std::string, std::string> double_metaphone(std::string str)
+  inline std::pair<std::string, std::string> double_metaphone(const std::string& str, const encode_limits& limits = encode_limits())
   {
     std::pair<std::string, std::string> result;
 
     // compose results from callback
-    double_metaphone(std::move(str),
+    double_metaphone(str.data(), str.size(),
                      [&result](const char* metaph1, const char* metaph2, size_t start, size_t len)
                      {
                        if (metaph1)
                          result.first += metaph1;
                        if (metaph2)
                          result.second += metaph2;
-                     });
+                     },
+                     limits);
     return result;
   }
 }
@@ -0,0 +1,205 @@
+//
+//  double_metaphone_arena.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_ARENA_H
+#define DM_DOUBLE_METAPHONE_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "double_metaphone.h"
+
+namespace dm
+{
+  /* the alignment of any scalar: libstdc++ before gcc 5 lacks std::max_align_t and gcc 4.8 ::max_align_t too, where long
+     double is the most aligned; clang claims __GNUC__ 4 but its own stddef.h has ::max_align_t */
+#if defined(__clang__)
+  const std::size_t max_alignment = alignof(::max_align_t);
+#elif defined(__GLIBCXX__) && defined(__GNUC__) && __GNUC__ < 5
+  const std::size_t max_alignment = alignof(long double);
+#else
+  const std::size_t max_alignment = alignof(std::max_align_t);
+#endif
+
+  /* hands out memory from a few large blocks, all freed at once by release() or destruction */
+  class arena
+  {
+  public:
+    explicit arena(std::size_t block_size = 64 * 1024): block_size_(block_size), next_(nullptr), left_(0)
+    {
+    }
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment = max_alignment)
+    {
+      std::size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(next_) % alignment) % alignment;
+      if (padding + size > left_)
+      {
+        /* sizes past a block get a block of their own */
+        const std::size_t block = std::max(block_size_, size + alignment);
+        blocks_.push_back(std::unique_ptr<char[]>(new char[block]));
+        next_ = blocks_.back().get();
+        left_ = block;
+        padding = (alignment - reinterpret_cast<std::uintptr_t>(next_) % alignment) % alignment;
+      }
+      char* allocated = next_ + padding;
+      next_ = allocated + size;
+      left_ -= padding + size;
+      return allocated;
+    }
+
+    /* frees every block */
+    void release()
+    {
+      blocks_.clear();
+      next_ = nullptr;
+      left_ = 0;
+    }
+
+    std::size_t blocks() const
+    {
+      return blocks_.size();
+    }
+
+  private:
+    std::size_t block_size_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* next_;
+    std::size_t left_;
+  };
+
+  /* a standard allocator drawing from an arena, deallocation doing nothing until the arena is released */
+  template <typename T> class arena_allocator
+  {
+  public:
+    typedef T value_type;
+
+    explicit arena_allocator(arena& memory): memory_(&memory)
+    {
+    }
+
+    template <typename U> arena_allocator(const arena_allocator<U>& other): memory_(other.memory())
+    {
+    }
+
+    T* allocate(std::size_t count)
+    {
+      return static_cast<T*>(memory_->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t)
+    {
+    }
+
+    arena* memory() const
+    {
+      return memory_;
+    }
+
+  private:
+    arena* memory_;
+  };
+
+  template <typename T, typename U> inline bool operator==(const arena_allocator<T>& allocator1, const arena_allocator<U>& allocator2)
+  {
+    return allocator1.memory() == allocator2.memory();
+  }
+
+  template <typename T, typename U> inline bool operator!=(const arena_allocator<T>& allocator1, const arena_allocator<U>& allocator2)
+  {
+    return allocator1.memory() != allocator2.memory();
+  }
+
+  typedef std::basic_string<char, std::char_traits<char>, arena_allocator<char>> arena_string;
+
+  /* like double_metaphone(str) but with the keys in memory */
+  inline std::pair<arena_string, arena_string> double_metaphone(const std::string& str, arena& memory, const encode_limits& limits = encode_limits())
+  {
+    const arena_allocator<char> allocator(memory);
+    auto result = std::make_pair(arena_string(allocator), arena_string(allocator));
+
+    // compose results from callback
+    double_metaphone(str,
+                     [&result](const char* metaph1, const char* metaph2, size_t start, size_t len)
+                     {
+                       if (metaph1)
+                         result.first += metaph1;
+                       if (metaph2)
+                         result.second += metaph2;
+                     },
+                     limits);
+    return result;
+  }
+
+  /* keys as null terminated strings held elsewhere */
+  struct key_strings
+  {
+    const char* first;
+    const char* second;
+  };
+
+  /* the keys of words into keys, their strings packed end to end in memory; keys the same share a string */
+  inline void double_metaphone(const std::string* words, std::size_t count, key_strings* keys, arena& memory, const encode_limits& limits = encode_limits())
+  {
+    std::string primary;
+    std::string alternate;
+    for (std::size_t word = 0; word < count; ++word)
+    {
+      primary.clear();
+      alternate.clear();
+      double_metaphone(words[word],
+                       [&](const char* metaph1, const char* metaph2, size_t start, size_t len)
+                       {
+                         if (metaph1)
+                           primary += metaph1;
+                         if (metaph2)
+                           alternate += metaph2;
+                       },
+                       limits);
+
+      /* the keys are usually the same, and then share a string */
+      const bool shared = primary == alternate;
+      char* strings = static_cast<char*>(memory.allocate(primary.size() + 1 + (shared ? 0 : alternate.size() + 1), 1));
+      std::memcpy(strings, primary.c_str(), primary.size() + 1);
+      if (!shared)
+        std::memcpy(strings + primary.size() + 1, alternate.c_str(), alternate.size() + 1);
+      keys[word].first = strings;
+      keys[word].second = shared ? strings : strings + primary.size() + 1;
+    }
+  }
+}
+
+#endif
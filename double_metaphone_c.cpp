@@ -0,0 +1,326 @@
+//
+//  double_metaphone_c.cpp
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "double_metaphone_c.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#include "double_metaphone_packed.h"
+
+/* the encoder built again for each x86-64 micro-architecture level, needing GCC 12 for the level names */
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12 && defined(__x86_64__)
+#define DM_C_LEVELS 1
+#endif
+
+namespace
+{
+  /* appends key parts into a caller buffer, noting when they overflow it */
+  struct key_writer
+  {
+    char* bytes;
+    size_t capacity;
+    size_t length;
+
+    void append(const char* metaph)
+    {
+      if (metaph)
+        for (; *metaph; ++metaph, ++length)
+          if (length < capacity)
+            bytes[length] = *metaph;
+    }
+
+    bool fits() const
+    {
+      return length <= capacity;
+    }
+  };
+
+  std::atomic<size_t> max_length(size_t(-1));
+  std::atomic<size_t> max_steps(size_t(-1));
+
+  dm::encode_limits current_limits()
+  {
+    return dm::encode_limits(max_length.load(std::memory_order_relaxed), max_steps.load(std::memory_order_relaxed));
+  }
+
+  inline void encode(const char* word, size_t word_length, key_writer& primary, key_writer& alternate, const dm::encode_limits& limits)
+  {
+    dm::double_metaphone(word, word_length,
+                         [&](const char* metaph1, const char* metaph2, size_t start, size_t len)
+                         {
+                           primary.append(metaph1);
+                           alternate.append(metaph2);
+                         },
+                         limits);
+  }
+
+  /* the entry points, built once for each level */
+  inline int encode_one(const char* word,
+                        size_t word_length,
+                        char* primary,
+                        size_t primary_capacity,
+                        size_t* primary_length,
+                        char* alternate,
+                        size_t alternate_capacity,
+                        size_t* alternate_length)
+  {
+    /* leave room for the NULs */
+    key_writer primary_writer = { primary, primary_capacity ? primary_capacity - 1 : 0, 0 };
+    key_writer alternate_writer = { alternate, alternate_capacity ? alternate_capacity - 1 : 0, 0 };
+    encode(word, word_length, primary_writer, alternate_writer, current_limits());
+
+    *primary_length = primary_writer.length;
+    *alternate_length = alternate_writer.length;
+    const bool primary_fits = primary_capacity && primary_writer.fits();
+    const bool alternate_fits = alternate_capacity && alternate_writer.fits();
+    if (primary_fits)
+      primary[primary_writer.length] = '\0';
+    if (alternate_fits)
+      alternate[alternate_writer.length] = '\0';
+    return primary_fits && alternate_fits ? DM_OK : DM_TRUNCATED;
+  }
+
+  inline int encode_batch(size_t count,
+                          const uint64_t* offsets,
+                          const char* bytes,
+                          uint64_t* primary_offsets,
+                          char* primary_bytes,
+                          size_t primary_capacity,
+                          uint64_t* alternate_offsets,
+                          char* alternate_bytes,
+                          size_t alternate_capacity,
+                          size_t* done)
+  {
+    key_writer primary = { primary_bytes, primary_capacity, 0 };
+    key_writer alternate = { alternate_bytes, alternate_capacity, 0 };
+    const auto limits = current_limits();
+    primary_offsets[0] = 0;
+    alternate_offsets[0] = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      encode(bytes + offsets[i], size_t(offsets[i + 1] - offsets[i]), primary, alternate, limits);
+      if (!primary.fits() || !alternate.fits())
+      {
+        *done = i;
+        return DM_TRUNCATED;
+      }
+      primary_offsets[i + 1] = primary.length;
+      alternate_offsets[i + 1] = alternate.length;
+    }
+    *done = count;
+    return DM_OK;
+  }
+
+  inline void encode_packed(const char* word, size_t word_length, uint64_t* primary, uint64_t* alternate)
+  {
+    const auto keys = dm::double_metaphone_packed(word, word_length, current_limits());
+    *primary = keys.first;
+    *alternate = keys.second;
+  }
+
+  inline void encode_packed_batch(size_t count, const uint64_t* offsets, const char* bytes, uint64_t* primary, uint64_t* alternate)
+  {
+    const auto limits = current_limits();
+    for (size_t i = 0; i < count; ++i)
+    {
+      const auto keys = dm::double_metaphone_packed(bytes + offsets[i], size_t(offsets[i + 1] - offsets[i]), limits);
+      primary[i] = keys.first;
+      alternate[i] = keys.second;
+    }
+  }
+
+  struct entry_points
+  {
+    decltype(&encode_one) one;
+    decltype(&encode_batch) batch;
+    decltype(&encode_packed) packed;
+    decltype(&encode_packed_batch) packed_batch;
+  };
+
+#ifdef DM_C_LEVELS
+  /* flatten inlines the whole encoder into each entry point, so all of it takes the level's instructions
+     and none of it is shared with the other levels */
+#define DM_C_LEVEL_ENTRY_POINTS(level, arch) \
+  __attribute__((target("arch=" arch), flatten)) int encode_one_##level(const char* word, size_t word_length, \
+    char* primary, size_t primary_capacity, size_t* primary_length, \
+    char* alternate, size_t alternate_capacity, size_t* alternate_length) \
+  { \
+    return encode_one(word, word_length, primary, primary_capacity, primary_length, alternate, alternate_capacity, alternate_length); \
+  } \
+  __attribute__((target("arch=" arch), flatten)) int encode_batch_##level(size_t count, const uint64_t* offsets, const char* bytes, \
+    uint64_t* primary_offsets, char* primary_bytes, size_t primary_capacity, \
+    uint64_t* alternate_offsets, char* alternate_bytes, size_t alternate_capacity, size_t* done) \
+  { \
+    return encode_batch(count, offsets, bytes, primary_offsets, primary_bytes, primary_capacity, \
+      alternate_offsets, alternate_bytes, alternate_capacity, done); \
+  } \
+  __attribute__((target("arch=" arch), flatten)) void encode_packed_##level(const char* word, size_t word_length, \
+    uint64_t* primary, uint64_t* alternate) \
+  { \
+    encode_packed(word, word_length, primary, alternate); \
+  } \
+  __attribute__((target("arch=" arch), flatten)) void encode_packed_batch_##level(size_t count, const uint64_t* offsets, \
+    const char* bytes, uint64_t* primary, uint64_t* alternate) \
+  { \
+    encode_packed_batch(count, offsets, bytes, primary, alternate); \
+  } \
+  const entry_points level = { encode_one_##level, encode_batch_##level, encode_packed_##level, encode_packed_batch_##level };
+
+  DM_C_LEVEL_ENTRY_POINTS(baseline, "x86-64")
+  DM_C_LEVEL_ENTRY_POINTS(v2, "x86-64-v2")
+  DM_C_LEVEL_ENTRY_POINTS(v3, "x86-64-v3")
+  DM_C_LEVEL_ENTRY_POINTS(v4, "x86-64-v4")
+#undef DM_C_LEVEL_ENTRY_POINTS
+#else
+  const entry_points baseline = { encode_one, encode_batch, encode_packed, encode_packed_batch };
+#endif
+
+  /* indexed by level */
+  const entry_points* const levels[] =
+  {
+    nullptr,
+    &baseline,
+#ifdef DM_C_LEVELS
+    &v2,
+    &v3,
+    &v4
+#endif
+  };
+
+  int supported_arch()
+  {
+#ifdef DM_C_LEVELS
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("x86-64-v4") ? DM_ARCH_X86_64_V4 :
+      __builtin_cpu_supports("x86-64-v3") ? DM_ARCH_X86_64_V3 :
+      __builtin_cpu_supports("x86-64-v2") ? DM_ARCH_X86_64_V2 :
+      DM_ARCH_BASELINE;
+#else
+    return DM_ARCH_BASELINE;
+#endif
+  }
+
+  /* what the CPU supports, lowered to the level named by DM_ARCH in the environment */
+  int chosen_arch()
+  {
+    const char* names[] = { nullptr, "x86-64", "x86-64-v2", "x86-64-v3", "x86-64-v4" };
+    int arch = supported_arch();
+    if (const char* name = std::getenv("DM_ARCH"))
+      for (int level = DM_ARCH_BASELINE; level < arch; ++level)
+        if (std::strcmp(name, names[level]) == 0)
+          arch = level;
+    return arch;
+  }
+
+  /* chosen once on first use */
+  std::atomic<int>& current_arch()
+  {
+    static std::atomic<int> arch(chosen_arch());
+    return arch;
+  }
+
+  const entry_points& current()
+  {
+    return *levels[current_arch().load(std::memory_order_relaxed)];
+  }
+}
+
+extern "C"
+{
+  int dm_abi_version(void)
+  {
+    return DM_ABI_VERSION;
+  }
+
+  int dm_arch(void)
+  {
+    return current_arch().load(std::memory_order_relaxed);
+  }
+
+  int dm_set_arch(int level)
+  {
+    const int arch = level < DM_ARCH_BASELINE ? DM_ARCH_BASELINE : level < supported_arch() ? level : supported_arch();
+    current_arch().store(arch, std::memory_order_relaxed);
+    return arch;
+  }
+
+  void dm_set_limits(size_t length, size_t steps)
+  {
+    max_length.store(length, std::memory_order_relaxed);
+    max_steps.store(steps, std::memory_order_relaxed);
+  }
+
+  void dm_limits(size_t* length, size_t* steps)
+  {
+    *length = max_length.load(std::memory_order_relaxed);
+    *steps = max_steps.load(std::memory_order_relaxed);
+  }
+
+  int dm_double_metaphone(const char* word,
+                          size_t word_length,
+                          char* primary,
+                          size_t primary_capacity,
+                          size_t* primary_length,
+                          char* alternate,
+                          size_t alternate_capacity,
+                          size_t* alternate_length)
+  {
+    return current().one(word, word_length, primary, primary_capacity, primary_length, alternate, alternate_capacity, alternate_length);
+  }
+
+  int dm_double_metaphone_batch(size_t count,
+                                const uint64_t* offsets,
+                                const char* bytes,
+                                uint64_t* primary_offsets,
+                                char* primary_bytes,
+                                size_t primary_capacity,
+                                uint64_t* alternate_offsets,
+                                char* alternate_bytes,
+                                size_t alternate_capacity,
+                                size_t* done)
+  {
+    return current().batch(count, offsets, bytes, primary_offsets, primary_bytes, primary_capacity,
+                           alternate_offsets, alternate_bytes, alternate_capacity, done);
+  }
+
+  void dm_double_metaphone_packed(const char* word, size_t word_length, uint64_t* primary, uint64_t* alternate)
+  {
+    current().packed(word, word_length, primary, alternate);
+  }
+
+  void dm_double_metaphone_packed_batch(size_t count,
+                                        const uint64_t* offsets,
+                                        const char* bytes,
+                                        uint64_t* primary,
+                                        uint64_t* alternate)
+  {
+    current().packed_batch(count, offsets, bytes, primary, alternate);
+  }
+}
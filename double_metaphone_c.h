@@ -0,0 +1,124 @@
+//
+//  double_metaphone_c.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ *  C interface for foreign callers, built into libdmetaphone from double_metaphone_c.cpp.
+ *  Words are UTF-8 bytes with explicit lengths; all buffers are owned by the caller.
+ */
+
+#ifndef DM_DOUBLE_METAPHONE_C_H
+#define DM_DOUBLE_METAPHONE_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define DM_API __declspec(dllexport)
+#else
+#define DM_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DM_ABI_VERSION 1
+
+enum
+{
+  DM_OK = 0,
+  DM_TRUNCATED = 1 /* an output buffer was too small */
+};
+
+/* x86-64 micro-architecture levels the encoder is built for; elsewhere only the baseline */
+enum
+{
+  DM_ARCH_BASELINE = 1,
+  DM_ARCH_X86_64_V2 = 2,
+  DM_ARCH_X86_64_V3 = 3,
+  DM_ARCH_X86_64_V4 = 4
+};
+
+/* DM_ABI_VERSION of the library, to check against the header */
+DM_API int dm_abi_version(void);
+
+/* the level the encoder runs at, chosen on first use: the best the CPU supports, or lower if named
+   by DM_ARCH in the environment as "x86-64", "x86-64-v2", "x86-64-v3" or "x86-64-v4" */
+DM_API int dm_arch(void);
+
+/* runs the encoder at level, or the best the CPU supports if that's lower, returning the level now in use */
+DM_API int dm_set_arch(int level);
+
+/* bounds on encoding each word by every entry point, as dm::encode_limits: bytes of the word read, cut back to
+   a whole UTF-8 character, and turns of the encoder's loop, each taking 1 to 3 letters; SIZE_MAX for no bound,
+   as at first. Set them before encoding untrusted input */
+DM_API void dm_set_limits(size_t max_length, size_t max_steps);
+
+DM_API void dm_limits(size_t* max_length, size_t* max_steps);
+
+/* writes each key NUL-terminated when it fits its buffer, and its length without the NUL;
+   keys are never longer than twice the word */
+DM_API int dm_double_metaphone(const char* word,
+                               size_t word_length,
+                               char* primary,
+                               size_t primary_capacity,
+                               size_t* primary_length,
+                               char* alternate,
+                               size_t alternate_capacity,
+                               size_t* alternate_length);
+
+/* encodes count words, word i being bytes[offsets[i]] up to bytes[offsets[i + 1]];
+   key i is written to primary_bytes[primary_offsets[i]] up to primary_bytes[primary_offsets[i + 1]],
+   likewise for alternate keys, without NULs. Stops at the first word whose keys don't fit,
+   returning DM_TRUNCATED with *done words written so the caller can resume from there;
+   capacities of twice the input bytes always suffice */
+DM_API int dm_double_metaphone_batch(size_t count,
+                                     const uint64_t* offsets,
+                                     const char* bytes,
+                                     uint64_t* primary_offsets,
+                                     char* primary_bytes,
+                                     size_t primary_capacity,
+                                     uint64_t* alternate_offsets,
+                                     char* alternate_bytes,
+                                     size_t alternate_capacity,
+                                     size_t* done);
+
+/* keys packed 4 bits per symbol as in double_metaphone_packed.h */
+DM_API void dm_double_metaphone_packed(const char* word, size_t word_length, uint64_t* primary, uint64_t* alternate);
+
+DM_API void dm_double_metaphone_packed_batch(size_t count,
+                                             const uint64_t* offsets,
+                                             const char* bytes,
+                                             uint64_t* primary,
+                                             uint64_t* alternate);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
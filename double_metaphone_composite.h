@@ -0,0 +1,113 @@
+//
+//  double_metaphone_composite.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_COMPOSITE_H
+#define DM_DOUBLE_METAPHONE_COMPOSITE_H
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "double_metaphone_index.h"
+#include "double_metaphone_postings.h"
+
+namespace dm
+{
+  /* symbols kept of each field of a composite key, longer field keys are truncated */
+  const std::size_t composite_field_capacity = packed_key_capacity / 2;
+
+  /* a packed key of two fields, the first field in the top half; composite keys sort by first field then second */
+  inline packed_key compose_keys(packed_key first, packed_key second)
+  {
+    return (first & packed_prefix_mask(composite_field_capacity)) | second >> 32;
+  }
+
+  /* the fields of a composite key, truncated */
+  inline std::pair<packed_key, packed_key> decompose_key(packed_key key)
+  {
+    return std::make_pair(key & packed_prefix_mask(composite_field_capacity), key << 32);
+  }
+
+  /* the distinct composite keys of every primary and alternate combination of two fields, at most 4 */
+  class composite_keys
+  {
+  public:
+    composite_keys(const packed_keys& first, const packed_keys& second): size_(0)
+    {
+      for (auto key1 : {first.first, first.second})
+        for (auto key2 : {second.first, second.second})
+        {
+          const auto key = compose_keys(key1, key2);
+          if (std::find(keys_, keys_ + size_, key) == keys_ + size_)
+            keys_[size_++] = key;
+        }
+    }
+
+    composite_keys(const std::string& first, const std::string& second):
+      composite_keys(double_metaphone_packed(first), double_metaphone_packed(second))
+    {
+    }
+
+    const packed_key* begin() const
+    {
+      return keys_;
+    }
+
+    const packed_key* end() const
+    {
+      return keys_ + size_;
+    }
+
+    std::size_t size() const
+    {
+      return size_;
+    }
+
+  private:
+    packed_key keys_[4];
+    std::size_t size_;
+  };
+
+  /* appends the ascending ids of the records having any of the keys, a point lookup each */
+  inline void composite_lookup(const index_view& index, const composite_keys& keys, std::vector<record_id>& ids)
+  {
+    std::vector<record_id> found;
+    std::vector<record_id> united;
+    for (auto key : keys)
+    {
+      const auto postings = index.lookup(key);
+      unite_ids(found.data(), found.size(), postings.begin(), postings.size(), united);
+      found.swap(united);
+      united.clear();
+    }
+    ids.insert(ids.end(), found.begin(), found.end());
+  }
+}
+
+#endif
@@ -0,0 +1,564 @@
+//
+//  double_metaphone_daemon.cpp
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+//  dmetaphoned: maps a phonetic index once per host and serves encode and lookup requests
+//  over a Unix domain socket, coalescing concurrent requests into batches.
+//
+//    dmetaphoned --build WORDS INDEX       index a file of names, one per line, id = line number from 1
+//    dmetaphoned SOCKET INDEX [LINGER_US]  serve until SIGINT or SIGTERM, then print latencies
+//    dmetaphoned --encode SOCKET WORD...   client requests
+//    dmetaphoned --lookup SOCKET WORD...
+//    dmetaphoned --stats SOCKET
+//
+//  Frames are in native byte order. A request is u32 size of the rest, u8 type, u32 tag, payload;
+//  a response is u32 size of the rest, u8 status, u32 tag echoing the request, payload. Requests
+//  over 16 MiB, or over 64 MiB of responses left unread, close the connection. Words, indexed or
+//  asked for, are encoded from at most their first 256 bytes in at most 256 steps.
+//
+//    encode  request: u32 count, count x (u32 length, bytes)
+//            response: u32 count, count x (u64 packed primary, u64 packed alternate)
+//    lookup  request: as encode
+//            response: u32 count, count x (u32 n, n x u32 record ids sharing either key, ascending)
+//    stats   request: empty
+//            response: text, per request type count and p50/p99/p999/max latencies
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "double_metaphone_frames.h"
+#include "double_metaphone_mapped.h"
+#include "latency_histogram.h"
+
+namespace
+{
+  enum request_type
+  {
+    request_encode = 1,
+    request_lookup = 2,
+    request_stats = 3,
+    request_types
+  };
+
+  enum response_status
+  {
+    status_ok = 0,
+    status_bad_request = 1
+  };
+
+  const char* request_names[request_types] = { "", "encode", "lookup", "stats" };
+
+  typedef std::chrono::steady_clock clock_type;
+
+  struct request
+  {
+    std::uint64_t connection;
+    std::uint8_t type;
+    std::uint32_t tag;
+    std::string payload;
+    clock_type::time_point arrival;
+  };
+
+  struct response
+  {
+    std::uint64_t connection;
+    std::string frame;
+  };
+
+  using dm::detail::get;
+  using dm::detail::put;
+
+  /* client words are untrusted, and names are far shorter */
+  const dm::encode_limits word_limits(256, 256);
+
+  /* responses a client may leave unread before it's dropped, so one that never reads can't exhaust memory */
+  const std::size_t max_output = std::size_t(64) << 20;
+
+  class server
+  {
+  public:
+    server(const dm::index_view& index, std::chrono::microseconds linger): index_(index), linger_(linger), stopping_(false)
+    {
+      if (::pipe(wake_) != 0)
+        throw std::runtime_error("dmetaphoned: can't make wake pipe");
+    }
+
+    ~server()
+    {
+      ::close(wake_[0]);
+      ::close(wake_[1]);
+    }
+
+    /* takes requests until stop, answering them as batches on a worker thread */
+    void serve(int listener, const std::atomic<bool>& interrupted)
+    {
+      std::thread worker([this] { work(); });
+
+      std::map<std::uint64_t, connection> connections;
+      std::uint64_t next_connection = 0;
+      std::vector<pollfd> polls;
+      std::vector<std::uint64_t> polled;
+      while (!interrupted)
+      {
+        polls.clear();
+        polled.clear();
+        polls.push_back(pollfd { listener, POLLIN, 0 });
+        polls.push_back(pollfd { wake_[0], POLLIN, 0 });
+        for (auto& open : connections)
+        {
+          polls.push_back(pollfd { open.second.fd, short(POLLIN | (open.second.output.empty() ? 0 : POLLOUT)), 0 });
+          polled.push_back(open.first);
+        }
+        if (::poll(polls.data(), polls.size(), 100) <= 0)
+          continue;
+
+        if (polls[0].revents & POLLIN)
+        {
+          /* never blocking, so one client that stops reading can't hold up the others */
+          const int fd = ::accept(listener, nullptr, nullptr);
+          if (fd >= 0 && ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK) == 0)
+            connections[next_connection++].fd = fd;
+          else if (fd >= 0)
+            ::close(fd);
+        }
+
+        if (polls[1].revents & POLLIN)
+        {
+          char drained[256];
+          if (::read(wake_[0], drained, sizeof(drained)) < 0)
+            continue;
+          std::lock_guard<std::mutex> lock(mutex_);
+          for (auto& answered : responses_)
+          {
+            auto found = connections.find(answered.connection);
+            if (found == connections.end())
+              continue;
+            if (found->second.output.size() + answered.frame.size() > max_output)
+            {
+              ::close(found->second.fd);
+              connections.erase(found);
+            }
+            else
+              found->second.output += answered.frame;
+          }
+          responses_.clear();
+        }
+
+        for (std::size_t i = 0; i < polled.size(); ++i)
+        {
+          auto found = connections.find(polled[i]);
+          if (found == connections.end())
+            continue;
+          auto& client = found->second;
+          bool closed = (polls[i + 2].revents & (POLLERR | POLLNVAL)) != 0;
+
+          if (!closed && (polls[i + 2].revents & (POLLIN | POLLHUP)))
+          {
+            char buffer[65536];
+            const ssize_t received = ::recv(client.fd, buffer, sizeof(buffer), 0);
+            if (received > 0)
+            {
+              client.input.append(buffer, std::size_t(received));
+              closed = !take_requests(polled[i], client.input);
+            }
+            else if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+              closed = true;
+          }
+
+          if (!closed && (polls[i + 2].revents & POLLOUT) && !client.output.empty())
+          {
+            /* whatever doesn't fit the socket buffer waits for the next POLLOUT */
+            const ssize_t sent = ::send(client.fd, client.output.data(), client.output.size(), MSG_NOSIGNAL);
+            if (sent >= 0)
+              client.output.erase(0, std::size_t(sent));
+            else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+              closed = true;
+          }
+
+          if (closed)
+          {
+            ::close(client.fd);
+            connections.erase(found);
+          }
+        }
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+      }
+      pending_.notify_one();
+      worker.join();
+      for (auto& open : connections)
+        ::close(open.second.fd);
+    }
+
+    std::string stats()
+    {
+      std::lock_guard<std::mutex> lock(stats_mutex_);
+      std::ostringstream text;
+      for (int type = request_encode; type < request_types; ++type)
+      {
+        const auto& histogram = latencies_[type];
+        text << request_names[type] << ": " << histogram.count() << " requests"
+          << ", p50 " << histogram.percentile(0.5) / 1000.0 << "us"
+          << ", p99 " << histogram.percentile(0.99) / 1000.0 << "us"
+          << ", p999 " << histogram.percentile(0.999) / 1000.0 << "us"
+          << ", max " << histogram.max() / 1000.0 << "us\n";
+      }
+      text << "batches: " << batches_.count() << ", p50 " << batches_.percentile(0.5)
+        << " requests, p99 " << batches_.percentile(0.99) << " requests\n";
+      return text.str();
+    }
+
+  private:
+    struct connection
+    {
+      int fd;
+      std::string input;
+      std::string output;
+    };
+
+    /* queues the complete frames in input, false if a frame is malformed or oversized */
+    bool take_requests(std::uint64_t connection, std::string& input)
+    {
+      std::vector<dm::request_frame> frames;
+      const bool valid = dm::take_frames(input, frames);
+      if (!frames.empty())
+      {
+        const auto now = clock_type::now();
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          for (auto& taken : frames)
+            requests_.push_back(request { connection, taken.type, taken.tag, std::move(taken.payload), now });
+        }
+        pending_.notify_one();
+      }
+      return valid;
+    }
+
+    /* answers whatever requests have queued up as one batch */
+    void work()
+    {
+      std::vector<request> batch;
+      for (;;)
+      {
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          pending_.wait(lock, [this] { return stopping_ || !requests_.empty(); });
+          if (stopping_)
+            return;
+
+          /* briefly let concurrent requests join the batch */
+          if (linger_.count())
+          {
+            lock.unlock();
+            std::this_thread::sleep_for(linger_);
+            lock.lock();
+          }
+          batch.assign(std::make_move_iterator(requests_.begin()), std::make_move_iterator(requests_.end()));
+          requests_.clear();
+        }
+
+        std::vector<response> answered = answer(batch);
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          for (auto& answer : answered)
+            responses_.push_back(std::move(answer));
+        }
+        const char wake = 0;
+        if (::write(wake_[1], &wake, 1) < 0)
+          std::cerr << "dmetaphoned: can't wake\n";
+      }
+    }
+
+    std::vector<response> answer(const std::vector<request>& batch)
+    {
+      /* encode all the words of the batch together */
+      std::vector<std::string> words;
+      std::vector<std::size_t> starts;
+      std::vector<bool> valid;
+      for (auto& asked : batch)
+      {
+        starts.push_back(words.size());
+        valid.push_back(asked.type != request_encode && asked.type != request_lookup ? asked.type == request_stats && asked.payload.empty() : dm::frame_words(asked.payload, words));
+      }
+      starts.push_back(words.size());
+
+      std::vector<dm::packed_keys> keys(words.size());
+      for (std::size_t i = 0; i < words.size(); ++i)
+        keys[i] = dm::double_metaphone_packed(words[i], word_limits);
+
+      std::vector<response> answered;
+      std::vector<dm::record_id> ids;
+      for (std::size_t which = 0; which < batch.size(); ++which)
+      {
+        auto& asked = batch[which];
+        std::string payload;
+        if (valid[which])
+          switch (asked.type)
+          {
+            case request_encode:
+              put(payload, std::uint32_t(starts[which + 1] - starts[which]));
+              for (auto word = starts[which]; word < starts[which + 1]; ++word)
+              {
+                put(payload, keys[word].first);
+                put(payload, keys[word].second);
+              }
+              break;
+
+            case request_lookup:
+              put(payload, std::uint32_t(starts[which + 1] - starts[which]));
+              for (auto word = starts[which]; word < starts[which + 1]; ++word)
+              {
+                const auto ids1 = index_.lookup(keys[word].first);
+                const auto ids2 = keys[word].second != keys[word].first ? index_.lookup(keys[word].second) : dm::id_range { nullptr, nullptr };
+                ids.clear();
+                std::set_union(ids1.begin(), ids1.end(), ids2.begin(), ids2.end(), std::back_inserter(ids));
+                put(payload, std::uint32_t(ids.size()));
+                payload.append(reinterpret_cast<const char*>(ids.data()), ids.size() * sizeof(dm::record_id));
+              }
+              break;
+
+            case request_stats:
+              payload = stats();
+              break;
+          }
+
+        answered.push_back(response { asked.connection, dm::make_frame(valid[which] ? status_ok : status_bad_request, asked.tag, payload) });
+      }
+
+      const auto now = clock_type::now();
+      std::lock_guard<std::mutex> lock(stats_mutex_);
+      for (std::size_t which = 0; which < batch.size(); ++which)
+        if (valid[which])
+          latencies_[batch[which].type].record(std::chrono::duration_cast<std::chrono::nanoseconds>(now - batch[which].arrival).count());
+      batches_.record(batch.size());
+      return answered;
+    }
+
+    dm::index_view index_;
+    std::chrono::microseconds linger_;
+    int wake_[2];
+
+    std::mutex mutex_;
+    std::condition_variable pending_;
+    std::deque<request> requests_;
+    std::vector<response> responses_;
+    bool stopping_;
+
+    std::mutex stats_mutex_;
+    dm::latency_histogram latencies_[request_types];
+    dm::latency_histogram batches_;
+  };
+
+  std::atomic<bool> interrupted(false);
+
+  void interrupt(int)
+  {
+    interrupted = true;
+  }
+
+  sockaddr_un socket_address(const std::string& path)
+  {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+      throw std::runtime_error("dmetaphoned: socket path too long " + path);
+    std::strcpy(address.sun_path, path.c_str());
+    return address;
+  }
+
+  int build(const std::string& words_path, const std::string& index_path)
+  {
+    std::ifstream words(words_path);
+    if (!words)
+      throw std::runtime_error("dmetaphoned: can't read " + words_path);
+    dm::index_builder builder;
+    std::string word;
+    for (dm::record_id id = 1; std::getline(words, word); ++id)
+      builder.add(id, word, word_limits);
+    const auto index = builder.build();
+    dm::write_index(index.view(), index_path);
+    std::cerr << index.size() << " keys, " << index.ids().size() << " postings\n";
+    return 0;
+  }
+
+  int serve(const std::string& socket_path, const std::string& index_path, int linger_us)
+  {
+    const dm::mapped_index index(index_path);
+
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    const auto address = socket_address(socket_path);
+    /* replaces a stale socket left by a previous run, but never a file that happens to be named like one */
+    struct stat existing;
+    if (::lstat(socket_path.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode))
+      ::unlink(socket_path.c_str());
+    if (listener < 0
+        || ::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listener, 128) != 0)
+      throw std::runtime_error("dmetaphoned: can't listen on " + socket_path);
+
+    std::signal(SIGINT, interrupt);
+    std::signal(SIGTERM, interrupt);
+
+    server serving(index.view(), std::chrono::microseconds(linger_us));
+    serving.serve(listener, interrupted);
+    ::close(listener);
+    ::unlink(socket_path.c_str());
+    std::cerr << serving.stats();
+    return 0;
+  }
+
+  /* sends one request and prints its response */
+  int client(std::uint8_t type, const std::string& socket_path, char** words, int count)
+  {
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    const auto address = socket_address(socket_path);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+      throw std::runtime_error("dmetaphoned: can't connect to " + socket_path);
+
+    std::string payload;
+    if (type != request_stats)
+    {
+      put(payload, std::uint32_t(count));
+      for (int i = 0; i < count; ++i)
+      {
+        put(payload, std::uint32_t(std::strlen(words[i])));
+        payload += words[i];
+      }
+    }
+    const std::string sending = dm::make_frame(type, 0, payload);
+    if (::send(fd, sending.data(), sending.size(), MSG_NOSIGNAL) != ssize_t(sending.size()))
+      throw std::runtime_error("dmetaphoned: can't send request");
+
+    std::string received;
+    char buffer[65536];
+    std::uint32_t size = 0;
+    for (std::size_t position = 0; !get(received, position, size) || received.size() < sizeof(size) + size; position = 0)
+    {
+      const ssize_t got = ::recv(fd, buffer, sizeof(buffer), 0);
+      if (got <= 0)
+        throw std::runtime_error("dmetaphoned: connection closed");
+      received.append(buffer, std::size_t(got));
+    }
+    ::close(fd);
+
+    std::size_t position = sizeof(size);
+    std::uint8_t status = status_bad_request;
+    std::uint32_t tag = 0;
+    get(received, position, status);
+    get(received, position, tag);
+    if (status != status_ok)
+    {
+      std::cerr << "bad request\n";
+      return 1;
+    }
+
+    std::uint32_t answers = 0;
+    if (type != request_stats)
+      get(received, position, answers);
+    else
+      std::cout << received.substr(position);
+    for (std::uint32_t i = 0; i < answers; ++i)
+    {
+      std::cout << words[i];
+      if (type == request_encode)
+      {
+        dm::packed_keys keys(0, 0);
+        get(received, position, keys.first);
+        get(received, position, keys.second);
+        std::cout << " " << dm::unpack_key(keys.first) << " " << dm::unpack_key(keys.second);
+      }
+      else
+      {
+        std::uint32_t n = 0;
+        get(received, position, n);
+        for (std::uint32_t j = 0; j < n; ++j)
+        {
+          dm::record_id id = 0;
+          get(received, position, id);
+          std::cout << " " << id;
+        }
+      }
+      std::cout << "\n";
+    }
+    return 0;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  try
+  {
+    const std::string command = argc > 1 ? argv[1] : "";
+    if (command == "--build" && argc == 4)
+      return build(argv[2], argv[3]);
+    if (command == "--encode" && argc >= 3)
+      return client(request_encode, argv[2], argv + 3, argc - 3);
+    if (command == "--lookup" && argc >= 3)
+      return client(request_lookup, argv[2], argv + 3, argc - 3);
+    if (command == "--stats" && argc == 3)
+      return client(request_stats, argv[2], nullptr, 0);
+    if (argc == 3 || argc == 4)
+      return serve(argv[1], argv[2], argc == 4 ? std::atoi(argv[3]) : 50);
+  }
+  catch (const std::exception& error)
+  {
+    std::cerr << error.what() << "\n";
+    return 1;
+  }
+
+  std::cerr << "usage: dmetaphoned --build WORDS INDEX\n"
+    "       dmetaphoned SOCKET INDEX [LINGER_US]\n"
+    "       dmetaphoned --encode|--lookup SOCKET WORD...\n"
+    "       dmetaphoned --stats SOCKET\n";
+  return 2;
+}
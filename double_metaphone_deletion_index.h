@@ -0,0 +1,163 @@
+//
+//  double_metaphone_deletion_index.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_DELETION_INDEX_H
+#define DM_DOUBLE_METAPHONE_DELETION_INDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "double_metaphone_distance.h"
+#include "double_metaphone_index.h"
+
+namespace dm
+{
+  /* key with the symbol at position removed */
+  inline packed_key packed_delete(packed_key key, std::size_t position)
+  {
+    const packed_key rest = position + 1 < packed_key_capacity ? (key << (4 * (position + 1))) >> (4 * position) : 0;
+    return (key & packed_prefix_mask(position)) | rest;
+  }
+
+  namespace detail
+  {
+    inline void add_deletions(packed_key key, std::size_t length, std::size_t from, unsigned deletions, std::vector<packed_key>& variants)
+    {
+      variants.push_back(key);
+      if (deletions)
+        for (std::size_t position = from; position < length; ++position)
+          add_deletions(packed_delete(key, position), length - 1, position, deletions - 1, variants);
+    }
+  }
+
+  /* appends the distinct keys made by deleting up to deletions symbols from key, including key itself */
+  inline void packed_deletions(packed_key key, unsigned deletions, std::vector<packed_key>& variants)
+  {
+    const auto start = variants.size();
+    detail::add_deletions(key, packed_length(key), 0, deletions, variants);
+    std::sort(variants.begin() + start, variants.end());
+    variants.erase(std::unique(variants.begin() + start, variants.end()), variants.end());
+  }
+
+  /* SymSpell style auxiliary index of the deletion variants of each key in an index, so keys within
+     an edit distance of a query are found by probing the query's own deletion variants; keys within
+     distance k share a variant with at most k deletions from each.
+
+     A key of length L has up to C(L, 0) + ... + C(L, k) variants, each costing a distinct variant (8 bytes)
+     plus offset (4 bytes) or just a key position (4 bytes) when shared; for typical 4-6 symbol keys that is
+     5-7 variants per key at k = 1, 11-22 at k = 2 and 15-42 at k = 3, so memory grows roughly as L^k / k!.
+
+     The viewed index must outlive this. */
+  class deletion_index
+  {
+  public:
+    deletion_index(const index_view& index, unsigned max_distance): index_(index), max_distance_(max_distance)
+    {
+      std::vector<std::pair<packed_key, std::uint32_t>> entries;
+      std::vector<packed_key> variants;
+      for (std::size_t position = 0; position < index.size(); ++position)
+      {
+        variants.clear();
+        packed_deletions(index.keys()[position], max_distance, variants);
+        for (auto variant : variants)
+          entries.push_back(std::make_pair(variant, std::uint32_t(position)));
+      }
+      std::sort(entries.begin(), entries.end());
+
+      positions_.reserve(entries.size());
+      for (auto& entry : entries)
+      {
+        if (variants_.empty() || variants_.back() != entry.first)
+        {
+          variants_.push_back(entry.first);
+          offsets_.push_back(std::uint32_t(positions_.size()));
+        }
+        positions_.push_back(entry.second);
+      }
+      offsets_.push_back(std::uint32_t(positions_.size()));
+    }
+
+    unsigned max_distance() const
+    {
+      return max_distance_;
+    }
+
+    /* number of variant to key position entries */
+    std::size_t entries() const
+    {
+      return positions_.size();
+    }
+
+    /* appends the ascending positions in the index of keys within distance of either query key,
+       distance being at most max_distance() */
+    void find(const packed_keys& query, unsigned distance, std::vector<std::size_t>& positions) const
+    {
+      distance = std::min(distance, max_distance_);
+
+      std::vector<packed_key> variants;
+      packed_deletions(query.first, distance, variants);
+      if (query.second != query.first)
+        packed_deletions(query.second, distance, variants);
+
+      const auto start = positions.size();
+      for (auto variant : variants)
+      {
+        auto found = std::lower_bound(variants_.begin(), variants_.end(), variant);
+        if (found != variants_.end() && *found == variant)
+        {
+          const auto which = found - variants_.begin();
+          positions.insert(positions.end(), positions_.begin() + offsets_[which], positions_.begin() + offsets_[which + 1]);
+        }
+      }
+      std::sort(positions.begin() + start, positions.end());
+      positions.erase(std::unique(positions.begin() + start, positions.end()), positions.end());
+
+      /* sharing a variant is necessary but not sufficient, so verify the distance */
+      const packed_distance_pattern pattern1(query.first);
+      const packed_distance_pattern pattern2(query.second);
+      auto kept = positions.begin() + start;
+      for (auto candidate = kept; candidate != positions.end(); ++candidate)
+      {
+        const auto key = index_.keys()[*candidate];
+        if (pattern1.distance(key, distance) <= distance || pattern2.distance(key, distance) <= distance)
+          *kept++ = *candidate;
+      }
+      positions.erase(kept, positions.end());
+    }
+
+  private:
+    index_view index_;
+    unsigned max_distance_;
+    std::vector<packed_key> variants_;
+    std::vector<std::uint32_t> offsets_;
+    std::vector<std::uint32_t> positions_;
+  };
+}
+
+#endif
@@ -0,0 +1,470 @@
+//
+//  double_metaphone_dictionary.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_DICTIONARY_H
+#define DM_DOUBLE_METAPHONE_DICTIONARY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "double_metaphone_mapped.h"
+
+namespace dm
+{
+  /* keys per front coded block, the first held whole */
+  const std::size_t dictionary_block_size = 16;
+
+  namespace detail
+  {
+    /* decodes the key following previous, a byte of shared symbols and suffix length then the suffix 2 symbols a byte */
+    inline packed_key front_decode(packed_key previous, const std::uint8_t*& bytes)
+    {
+      const unsigned shared = *bytes >> 4;
+      const unsigned suffix = (*bytes++ & 0xF) + 1;
+      packed_key symbols = 0;
+      for (unsigned i = 0; i < suffix; i += 2)
+        symbols = symbols << 8 | *bytes++;
+      if (suffix & 1)
+        symbols >>= 4;
+      return (previous & packed_prefix_mask(shared)) | symbols << (64 - 4 * (shared + suffix));
+    }
+
+    inline void front_encode(packed_key previous, packed_key key, std::vector<std::uint8_t>& bytes)
+    {
+      /* keys are distinct and ascending, so key has at least one symbol past those it shares with previous */
+      unsigned shared = 0;
+      while (shared < packed_key_capacity && ((previous ^ key) >> (60 - 4 * shared) & 0xF) == 0)
+        ++shared;
+      const unsigned suffix = unsigned(packed_length(key)) - shared;
+      bytes.push_back(std::uint8_t(shared << 4 | (suffix - 1)));
+      const packed_key symbols = key << (4 * shared);
+      for (unsigned i = 0; i < suffix; i += 2)
+        bytes.push_back(std::uint8_t(symbols >> (56 - 4 * i)));
+    }
+  }
+
+  namespace detail
+  {
+    /* whether each block of size keys decodes from exactly its own bytes to keys ascending from the last block's,
+       so a mapped file can be read without running past its bytes */
+    inline bool valid_front_coded(const packed_key* heads, const std::uint32_t* starts, const std::uint8_t* bytes, std::size_t size)
+    {
+      packed_key last = 0;
+      for (std::size_t block = 0, position = 0; position < size; ++block)
+      {
+        if (position && heads[block] <= last)
+          return false;
+        last = heads[block];
+        const std::uint8_t* next = bytes + starts[block];
+        const std::uint8_t* end = bytes + starts[block + 1];
+        for (++position; position < size && position % dictionary_block_size; ++position)
+        {
+          if (next == end)
+            return false;
+          const unsigned shared = *next >> 4;
+          const unsigned suffix = (*next & 0xF) + 1;
+          if (shared > packed_length(last) || shared + suffix > packed_key_capacity
+              || std::size_t(end - next) < 1 + (suffix + 1) / 2)
+            return false;
+          const packed_key key = front_decode(last, next);
+          if (key <= last)
+            return false;
+          last = key;
+        }
+        if (next != end)
+          return false;
+      }
+      return true;
+    }
+  }
+
+  /* distinct ascending keys front coded in blocks over arrays held elsewhere, e.g. mapped from a file:
+     heads()[b] is key b * dictionary_block_size, the rest of block b are coded from bytes()[starts()[b]] */
+  class dictionary_view
+  {
+  public:
+    /* walks keys in order, decoding each from the last */
+    class const_iterator
+    {
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef packed_key value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const packed_key* pointer;
+      typedef const packed_key& reference;
+
+      const_iterator(): dictionary_(nullptr), position_(0), key_(0), bytes_(nullptr)
+      {
+      }
+
+      const packed_key& operator*() const
+      {
+        return key_;
+      }
+
+      const packed_key* operator->() const
+      {
+        return &key_;
+      }
+
+      /* rank of the key */
+      std::size_t position() const
+      {
+        return position_;
+      }
+
+      const_iterator& operator++()
+      {
+        if (++position_ % dictionary_block_size == 0)
+          seek();
+        else if (position_ < dictionary_->size_)
+          key_ = detail::front_decode(key_, bytes_);
+        return *this;
+      }
+
+      const_iterator operator++(int)
+      {
+        const_iterator previous(*this);
+        ++*this;
+        return previous;
+      }
+
+      bool operator==(const const_iterator& other) const
+      {
+        return position_ == other.position_;
+      }
+
+      bool operator!=(const const_iterator& other) const
+      {
+        return position_ != other.position_;
+      }
+
+    private:
+      friend class dictionary_view;
+
+      const_iterator(const dictionary_view* dictionary, std::size_t position):
+        dictionary_(dictionary),
+        position_(std::min(position, dictionary->size_)),
+        key_(0),
+        bytes_(nullptr)
+      {
+        if (position_ < dictionary_->size_)
+        {
+          const std::size_t target = position_;
+          position_ -= position_ % dictionary_block_size;
+          seek();
+          while (position_ < target)
+          {
+            ++position_;
+            key_ = detail::front_decode(key_, bytes_);
+          }
+        }
+      }
+
+      /* moves to the head of the block at position, if any */
+      void seek()
+      {
+        if (position_ < dictionary_->size_)
+        {
+          const std::size_t block = position_ / dictionary_block_size;
+          key_ = dictionary_->heads_[block];
+          bytes_ = dictionary_->bytes_ + dictionary_->starts_[block];
+        }
+      }
+
+      const dictionary_view* dictionary_;
+      std::size_t position_;
+      packed_key key_;
+      const std::uint8_t* bytes_;
+    };
+
+    dictionary_view(const packed_key* heads, const std::uint32_t* starts, const std::uint8_t* bytes, std::size_t size):
+      heads_(heads),
+      starts_(starts),
+      bytes_(bytes),
+      size_(size)
+    {
+    }
+
+    const packed_key* heads() const
+    {
+      return heads_;
+    }
+
+    const std::uint32_t* starts() const
+    {
+      return starts_;
+    }
+
+    const std::uint8_t* bytes() const
+    {
+      return bytes_;
+    }
+
+    std::size_t size() const
+    {
+      return size_;
+    }
+
+    std::size_t blocks() const
+    {
+      return (size_ + dictionary_block_size - 1) / dictionary_block_size;
+    }
+
+    const_iterator begin() const
+    {
+      return const_iterator(this, 0);
+    }
+
+    const_iterator end() const
+    {
+      return const_iterator(this, size_);
+    }
+
+    /* iterator to the key of a rank */
+    const_iterator at(std::size_t position) const
+    {
+      return const_iterator(this, position);
+    }
+
+    /* key of a rank */
+    packed_key select(std::size_t position) const
+    {
+      return *at(position);
+    }
+
+    /* number of keys less than key */
+    std::size_t rank(packed_key key) const
+    {
+      const packed_key* after = std::upper_bound(heads_, heads_ + blocks(), key);
+      if (after == heads_)
+        return 0;
+
+      const std::size_t block = after - heads_ - 1;
+      std::size_t position = block * dictionary_block_size;
+      packed_key found = heads_[block];
+      const std::uint8_t* bytes = bytes_ + starts_[block];
+      const std::size_t last = std::min(position + dictionary_block_size, size_);
+      for (; found < key; found = detail::front_decode(found, bytes))
+        if (++position == last)
+          break;
+      return position;
+    }
+
+    /* rank of key, or size() if absent */
+    std::size_t find(packed_key key) const
+    {
+      const auto position = rank(key);
+      return position != size_ && select(position) == key ? position : size_;
+    }
+
+    /* ranks of the keys starting with the first len symbols of prefix, first and last */
+    std::pair<std::size_t, std::size_t> prefix_range(packed_key prefix, std::size_t len) const
+    {
+      const packed_key mask = packed_prefix_mask(len);
+      prefix &= mask;
+      const packed_key after = prefix + (~mask + 1);
+      return std::make_pair(rank(prefix), after > prefix ? rank(after) : size_);
+    }
+
+  private:
+    const packed_key* heads_;
+    const std::uint32_t* starts_;
+    const std::uint8_t* bytes_;
+    std::size_t size_;
+  };
+
+  /* distinct ascending keys front coded in blocks, a few bytes a key */
+  class dictionary
+  {
+  public:
+    dictionary(): starts_(1, 0)
+    {
+    }
+
+    /* keys must be distinct and ascending */
+    dictionary(const packed_key* keys, std::size_t size): size_(size)
+    {
+      const std::size_t blocks = (size + dictionary_block_size - 1) / dictionary_block_size;
+      heads_.reserve(blocks);
+      starts_.reserve(blocks + 1);
+      for (std::size_t position = 0; position < size; ++position)
+        if (position % dictionary_block_size == 0)
+        {
+          heads_.push_back(keys[position]);
+          starts_.push_back(std::uint32_t(bytes_.size()));
+        }
+        else
+          detail::front_encode(keys[position - 1], keys[position], bytes_);
+      starts_.push_back(std::uint32_t(bytes_.size()));
+    }
+
+    explicit dictionary(const index_view& index): dictionary(index.keys(), index.size())
+    {
+    }
+
+    /* from the parts in front coded form */
+    dictionary(std::vector<packed_key> heads, std::vector<std::uint32_t> starts, std::vector<std::uint8_t> bytes, std::size_t size):
+      heads_(std::move(heads)),
+      starts_(std::move(starts)),
+      bytes_(std::move(bytes)),
+      size_(size)
+    {
+    }
+
+    std::size_t size() const
+    {
+      return size_;
+    }
+
+    /* bytes held by the coded keys */
+    std::size_t memory_size() const
+    {
+      return heads_.size() * sizeof(packed_key) + starts_.size() * sizeof(std::uint32_t) + bytes_.size();
+    }
+
+    dictionary_view view() const
+    {
+      return dictionary_view(heads_.data(), starts_.data(), bytes_.data(), size_);
+    }
+
+    packed_key select(std::size_t position) const
+    {
+      return view().select(position);
+    }
+
+    std::size_t rank(packed_key key) const
+    {
+      return view().rank(key);
+    }
+
+    std::size_t find(packed_key key) const
+    {
+      return view().find(key);
+    }
+
+    std::pair<std::size_t, std::size_t> prefix_range(packed_key prefix, std::size_t len) const
+    {
+      return view().prefix_range(prefix, len);
+    }
+
+  private:
+    std::vector<packed_key> heads_;
+    std::vector<std::uint32_t> starts_;
+    std::vector<std::uint8_t> bytes_;
+    std::size_t size_ = 0;
+  };
+
+  /* dictionary file layout, in native byte order: this header, then heads, starts and bytes */
+  struct dictionary_file_header
+  {
+    char magic[8];
+    std::uint64_t keys;
+    std::uint64_t bytes;
+  };
+
+  namespace detail
+  {
+    const char dictionary_file_magic[8] = { 'D', 'M', 'D', 'I', 'C', 'T', '0', '1' };
+  }
+
+  inline void write_dictionary(const dictionary_view& dictionary, const std::string& path)
+  {
+    dictionary_file_header header;
+    std::memcpy(header.magic, detail::dictionary_file_magic, sizeof(header.magic));
+    header.keys = dictionary.size();
+    header.bytes = dictionary.starts()[dictionary.blocks()];
+
+    const std::size_t blocks = dictionary.blocks();
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    bool written = file
+      && std::fwrite(&header, sizeof(header), 1, file) == 1
+      && (!blocks || std::fwrite(dictionary.heads(), sizeof(packed_key), blocks, file) == blocks)
+      && std::fwrite(dictionary.starts(), sizeof(std::uint32_t), blocks + 1, file) == blocks + 1
+      && (!header.bytes || std::fwrite(dictionary.bytes(), 1, header.bytes, file) == header.bytes);
+    if (file)
+      written = std::fclose(file) == 0 && written;
+    if (!written)
+      throw std::runtime_error("double_metaphone: can't write dictionary " + path);
+  }
+
+  /* a dictionary file mapped read only, shared with every other process mapping it */
+  class mapped_dictionary
+  {
+  public:
+    explicit mapped_dictionary(const std::string& path): file_(path, "dictionary")
+    {
+      dictionary_file_header header;
+      if (file_.size() < sizeof(header))
+        throw std::runtime_error("double_metaphone: not a dictionary " + path);
+      std::memcpy(&header, file_.data(), sizeof(header));
+      const std::uint64_t blocks = header.keys / dictionary_block_size + (header.keys % dictionary_block_size != 0);
+      std::size_t left = file_.size() - sizeof(header);
+      if (std::memcmp(header.magic, detail::dictionary_file_magic, sizeof(header.magic)) != 0
+          || !detail::take_part(left, blocks, sizeof(packed_key))
+          || !detail::take_part(left, blocks + 1, sizeof(std::uint32_t))
+          || !detail::take_part(left, header.bytes, 1)
+          || left != 0)
+        throw std::runtime_error("double_metaphone: not a dictionary " + path);
+
+      const char* heads = file_.data() + sizeof(header);
+      const char* starts = heads + blocks * sizeof(packed_key);
+      const char* bytes = starts + (blocks + 1) * sizeof(std::uint32_t);
+      heads_ = reinterpret_cast<const packed_key*>(heads);
+      starts_ = reinterpret_cast<const std::uint32_t*>(starts);
+      bytes_ = reinterpret_cast<const std::uint8_t*>(bytes);
+      size_ = std::size_t(header.keys);
+
+      /* blocks must stay inside the bytes and decode from exactly theirs */
+      if (!detail::ascending_offsets(starts_, std::size_t(blocks), header.bytes)
+          || !detail::valid_front_coded(heads_, starts_, bytes_, size_))
+        throw std::runtime_error("double_metaphone: corrupt dictionary " + path);
+    }
+
+    dictionary_view view() const
+    {
+      return dictionary_view(heads_, starts_, bytes_, size_);
+    }
+
+  private:
+    detail::mapped_file file_;
+    const packed_key* heads_;
+    const std::uint32_t* starts_;
+    const std::uint8_t* bytes_;
+    std::size_t size_;
+  };
+}
+
+#endif
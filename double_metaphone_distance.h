@@ -0,0 +1,156 @@
+//
+//  double_metaphone_distance.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_DISTANCE_H
+#define DM_DOUBLE_METAPHONE_DISTANCE_H
+
+#include <algorithm>
+#include <cstdint>
+
+#include "double_metaphone_packed.h"
+
+namespace dm
+{
+  /* Myers' bit-parallel edit distance, with Hyyrö's changes for global distance, between a packed
+     pattern key and other packed keys; the pattern's equality masks are built once per pattern */
+  class packed_distance_pattern
+  {
+  public:
+    explicit packed_distance_pattern(packed_key pattern): length_(0)
+    {
+      std::fill(peq_, peq_ + 16, 0);
+      for (; pattern; pattern <<= 4)
+        peq_[pattern >> 60] |= std::uint32_t(1) << length_++;
+    }
+
+    std::size_t length() const
+    {
+      return length_;
+    }
+
+    unsigned distance(packed_key key) const
+    {
+      return distance(key, unsigned(packed_key_capacity));
+    }
+
+    /* distance when at most bound, otherwise bound + 1, stopping as soon as that is certain */
+    unsigned distance(packed_key key, unsigned bound) const
+    {
+      const unsigned key_length = unsigned(packed_length(key));
+      const unsigned pattern_length = unsigned(length_);
+      if ((key_length > pattern_length ? key_length - pattern_length : pattern_length - key_length) > bound)
+        return bound + 1;
+      if (!pattern_length)
+        return key_length;
+
+      const std::uint32_t top = std::uint32_t(1) << (pattern_length - 1);
+      std::uint32_t pv = ~std::uint32_t(0);
+      std::uint32_t mv = 0;
+      unsigned score = pattern_length;
+      unsigned remaining = key_length;
+      for (; key; key <<= 4)
+      {
+        const std::uint32_t eq = peq_[key >> 60];
+        const std::uint32_t xv = eq | mv;
+        const std::uint32_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        std::uint32_t ph = mv | ~(xh | pv);
+        std::uint32_t mh = pv & xh;
+        if (ph & top)
+          ++score;
+        else if (mh & top)
+          --score;
+
+        /* each remaining key symbol lowers the distance by at most one */
+        if (score > bound + --remaining)
+          return bound + 1;
+
+        /* top row is the distance from the empty pattern, so always rises */
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+      }
+      return score;
+    }
+
+  private:
+    std::uint32_t peq_[16];
+    std::size_t length_;
+  };
+
+  inline unsigned packed_distance(packed_key pattern, packed_key key)
+  {
+    return packed_distance_pattern(pattern).distance(key);
+  }
+
+  inline unsigned packed_distance(packed_key pattern, packed_key key, unsigned bound)
+  {
+    return packed_distance_pattern(pattern).distance(key, bound);
+  }
+
+  /* least distance between any key of one pair and any key of the other */
+  inline unsigned packed_distance(const packed_keys& pattern, const packed_keys& keys, unsigned bound)
+  {
+    const packed_distance_pattern pattern1(pattern.first);
+    unsigned distance = pattern1.distance(keys.first, bound);
+    if (distance)
+      distance = std::min(distance, pattern1.distance(keys.second, bound));
+    if (distance && pattern.second != pattern.first)
+    {
+      const packed_distance_pattern pattern2(pattern.second);
+      distance = std::min(distance, pattern2.distance(keys.first, bound));
+      if (distance)
+        distance = std::min(distance, pattern2.distance(keys.second, bound));
+    }
+    return distance;
+  }
+
+  /* distances from pattern to each key */
+  inline void packed_distances(packed_key pattern, const packed_key* keys, std::size_t count, std::uint8_t* distances)
+  {
+    const packed_distance_pattern compiled(pattern);
+    for (std::size_t i = 0; i < count; ++i)
+      distances[i] = std::uint8_t(compiled.distance(keys[i]));
+  }
+
+  /* distances from pattern to each key capped at bound + 1, returns the number within bound */
+  inline std::size_t packed_distances(packed_key pattern, const packed_key* keys, std::size_t count, unsigned bound, std::uint8_t* distances)
+  {
+    const packed_distance_pattern compiled(pattern);
+    std::size_t within = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const unsigned distance = compiled.distance(keys[i], bound);
+      distances[i] = std::uint8_t(distance);
+      within += distance <= bound;
+    }
+    return within;
+  }
+}
+
+#endif
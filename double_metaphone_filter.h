@@ -0,0 +1,177 @@
+//
+//  double_metaphone_filter.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_FILTER_H
+#define DM_DOUBLE_METAPHONE_FILTER_H
+
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "double_metaphone_index.h"
+
+namespace dm
+{
+  /* a cache line of filter bits */
+  struct alignas(64) filter_block
+  {
+    std::uint64_t words[8];
+  };
+
+  /* a standard allocator honouring alignments above the default operator new's, by over-allocating
+     and keeping the start of the allocation just before the aligned storage */
+  template <typename T> class aligned_allocator
+  {
+  public:
+    typedef T value_type;
+
+    aligned_allocator()
+    {
+    }
+
+    template <typename U> aligned_allocator(const aligned_allocator<U>&)
+    {
+    }
+
+    T* allocate(std::size_t count)
+    {
+      const std::size_t padding = alignof(T) + sizeof(void*);
+      if (count > (std::size_t(-1) - padding) / sizeof(T))
+        throw std::bad_alloc();
+      void* start = ::operator new(count * sizeof(T) + padding);
+      const auto address = reinterpret_cast<std::uintptr_t>(start) + sizeof(void*);
+      void** aligned = reinterpret_cast<void**>((address + alignof(T) - 1) / alignof(T) * alignof(T));
+      aligned[-1] = start;
+      return reinterpret_cast<T*>(aligned);
+    }
+
+    void deallocate(T* pointer, std::size_t)
+    {
+      ::operator delete(reinterpret_cast<void**>(pointer)[-1]);
+    }
+  };
+
+  template <typename T, typename U> inline bool operator==(const aligned_allocator<T>&, const aligned_allocator<U>&)
+  {
+    return true;
+  }
+
+  template <typename T, typename U> inline bool operator!=(const aligned_allocator<T>&, const aligned_allocator<U>&)
+  {
+    return false;
+  }
+
+  typedef std::vector<filter_block, aligned_allocator<filter_block>> filter_blocks;
+
+  /* split block Bloom filter of packed keys: each key sets one bit in each word of a single block,
+     so a lookup, hit or miss, reads one cache line; around 12 bits per key gives under 0.5% false positives */
+  class key_filter
+  {
+  public:
+    key_filter(): blocks_(1)
+    {
+    }
+
+    explicit key_filter(std::size_t count, unsigned bits_per_key = 12):
+      blocks_(std::max<std::size_t>((count * bits_per_key + 511) / 512, 1))
+    {
+    }
+
+    /* all the keys of an index, built or mapped */
+    explicit key_filter(const index_view& index, unsigned bits_per_key = 12): key_filter(index.size(), bits_per_key)
+    {
+      for (std::size_t i = 0; i < index.size(); ++i)
+        add(index.keys()[i]);
+    }
+
+    explicit key_filter(const index& index, unsigned bits_per_key = 12): key_filter(index.view(), bits_per_key)
+    {
+    }
+
+    void add(packed_key key)
+    {
+      const auto hash = mix(key);
+      auto& block = blocks_[block_of(hash)];
+      for (unsigned word = 0; word < 8; ++word)
+        block.words[word] |= bit_of(hash, word);
+    }
+
+    bool may_contain(packed_key key) const
+    {
+      const auto hash = mix(key);
+      const auto& block = blocks_[block_of(hash)];
+      std::uint64_t missing = 0;
+      for (unsigned word = 0; word < 8; ++word)
+        missing |= bit_of(hash, word) & ~block.words[word];
+      return !missing;
+    }
+
+    /* whether either key may be present, right after encoding */
+    bool may_contain(const packed_keys& keys) const
+    {
+      return may_contain(keys.first) || (keys.second != keys.first && may_contain(keys.second));
+    }
+
+    const filter_blocks& blocks() const
+    {
+      return blocks_;
+    }
+
+  private:
+    /* murmur3 finalizer, packed keys being far from uniform */
+    static std::uint64_t mix(packed_key key)
+    {
+      key ^= key >> 33;
+      key *= 0xFF51AFD7ED558CCDull;
+      key ^= key >> 33;
+      key *= 0xC4CEB9FE1A85EC53ull;
+      key ^= key >> 33;
+      return key;
+    }
+
+    std::size_t block_of(std::uint64_t hash) const
+    {
+      return std::size_t(((hash >> 32) * blocks_.size()) >> 32);
+    }
+
+    /* the low half of the hash, salted per word, picks a bit of each word */
+    static std::uint64_t bit_of(std::uint64_t hash, unsigned word)
+    {
+      static const std::uint32_t salts[8] =
+      {
+        0x47B6137Bu, 0x44974D91u, 0x8824AD5Bu, 0xA2B7289Du,
+        0x705495C7u, 0x2DF1424Bu, 0x9EFC4947u, 0x5C6BFB31u
+      };
+      return std::uint64_t(1) << ((std::uint32_t(hash) * salts[word]) >> 26);
+    }
+
+    filter_blocks blocks_;
+  };
+}
+
+#endif
@@ -0,0 +1,133 @@
+//
+//  double_metaphone_frames.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_FRAMES_H
+#define DM_DOUBLE_METAPHONE_FRAMES_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace dm
+{
+  /* frames of the dmetaphoned protocol, in native byte order: u32 size of the rest, u8 type or status, u32 tag, payload */
+
+  /* largest frame a server takes, past which it drops the connection rather than buffer it */
+  const std::uint32_t max_frame_size = 16 << 20;
+
+  struct request_frame
+  {
+    std::uint8_t type;
+    std::uint32_t tag;
+    std::string payload;
+  };
+
+  namespace detail
+  {
+    template <typename T> void put(std::string& buffer, T value)
+    {
+      buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <typename T> bool get(const std::string& buffer, std::size_t& position, T& value)
+    {
+      if (buffer.size() - position < sizeof(value))
+        return false;
+      std::memcpy(&value, buffer.data() + position, sizeof(value));
+      position += sizeof(value);
+      return true;
+    }
+  }
+
+  inline std::string make_frame(std::uint8_t type, std::uint32_t tag, const std::string& payload)
+  {
+    std::string framed;
+    detail::put(framed, std::uint32_t(sizeof(type) + sizeof(tag) + payload.size()));
+    detail::put(framed, type);
+    detail::put(framed, tag);
+    return framed + payload;
+  }
+
+  /* moves the complete frames at the start of input into frames, leaving a partial frame for more input;
+     false if a frame is too short to hold its type and tag or longer than max_size */
+  inline bool take_frames(std::string& input, std::vector<request_frame>& frames, std::uint32_t max_size = max_frame_size)
+  {
+    std::size_t position = 0;
+    bool valid = true;
+    for (;;)
+    {
+      const std::size_t start = position;
+      std::uint32_t size;
+      if (!detail::get(input, position, size))
+      {
+        position = start;
+        break;
+      }
+      if (size < sizeof(std::uint8_t) + sizeof(std::uint32_t) || size > max_size)
+      {
+        valid = false;
+        break;
+      }
+      if (input.size() - position < size)
+      {
+        position = start;
+        break;
+      }
+
+      request_frame taking;
+      detail::get(input, position, taking.type);
+      detail::get(input, position, taking.tag);
+      taking.payload = input.substr(position, size - sizeof(taking.type) - sizeof(taking.tag));
+      position = start + sizeof(size) + size;
+      frames.push_back(std::move(taking));
+    }
+    input.erase(0, position);
+    return valid;
+  }
+
+  /* words of an encode or lookup payload: u32 count, count x (u32 length, bytes) */
+  inline bool frame_words(const std::string& payload, std::vector<std::string>& words)
+  {
+    std::size_t position = 0;
+    std::uint32_t count;
+    if (!detail::get(payload, position, count))
+      return false;
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+      std::uint32_t length;
+      if (!detail::get(payload, position, length) || payload.size() - position < length)
+        return false;
+      words.push_back(payload.substr(position, length));
+      position += length;
+    }
+    return position == payload.size();
+  }
+}
+
+#endif
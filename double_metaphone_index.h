@@ -0,0 +1,277 @@
+//
+//  double_metaphone_index.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_INDEX_H
+#define DM_DOUBLE_METAPHONE_INDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "double_metaphone_packed.h"
+
+namespace dm
+{
+  typedef std::uint32_t record_id;
+
+  /* ids of the records having a key, ascending */
+  struct id_range
+  {
+    const record_id* first;
+    const record_id* last;
+
+    const record_id* begin() const
+    {
+      return first;
+    }
+
+    const record_id* end() const
+    {
+      return last;
+    }
+
+    std::size_t size() const
+    {
+      return last - first;
+    }
+
+    bool empty() const
+    {
+      return first == last;
+    }
+  };
+
+  /* an index in offsets + ids form over arrays held elsewhere, e.g. mapped from a file */
+  class index_view
+  {
+  public:
+    index_view(const packed_key* keys, std::size_t size, const std::uint32_t* offsets, const record_id* ids):
+      keys_(keys),
+      size_(size),
+      offsets_(offsets),
+      ids_(ids)
+    {
+    }
+
+    const packed_key* keys() const
+    {
+      return keys_;
+    }
+
+    const std::uint32_t* offsets() const
+    {
+      return offsets_;
+    }
+
+    const record_id* ids() const
+    {
+      return ids_;
+    }
+
+    std::size_t size() const
+    {
+      return size_;
+    }
+
+    std::size_t find(packed_key key) const
+    {
+      auto found = std::lower_bound(keys_, keys_ + size_, key);
+      return found != keys_ + size_ && *found == key ? found - keys_ : size_;
+    }
+
+    id_range postings(std::size_t position) const
+    {
+      return id_range { ids_ + offsets_[position], ids_ + offsets_[position + 1] };
+    }
+
+    id_range lookup(packed_key key) const
+    {
+      const auto position = find(key);
+      if (position == size_)
+        return id_range { nullptr, nullptr };
+      return postings(position);
+    }
+
+    /* positions of the keys starting with the first len symbols of prefix, first and last */
+    std::pair<std::size_t, std::size_t> prefix_range(packed_key prefix, std::size_t len) const
+    {
+      const packed_key mask = packed_prefix_mask(len);
+      prefix &= mask;
+      const packed_key after = prefix + (~mask + 1);
+      const std::size_t first = std::lower_bound(keys_, keys_ + size_, prefix) - keys_;
+      const std::size_t last = after > prefix ? std::lower_bound(keys_ + first, keys_ + size_, after) - keys_ : size_;
+      return std::make_pair(first, last);
+    }
+
+  private:
+    const packed_key* keys_;
+    std::size_t size_;
+    const std::uint32_t* offsets_;
+    const record_id* ids_;
+  };
+
+  /* phonetic keys and the records having them in offsets + ids form:
+     keys are distinct and ascending, the ids of keys()[i] are ids()[offsets()[i]] up to ids()[offsets()[i + 1]] */
+  class index
+  {
+  public:
+    typedef std::pair<packed_key, record_id> entry;
+
+    index(): offsets_(1, 0)
+    {
+    }
+
+    /* entries may be in any order and repeated */
+    explicit index(std::vector<entry> entries)
+    {
+      std::sort(entries.begin(), entries.end());
+      entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+      assign(entries);
+    }
+
+    /* from the parts in offsets + ids form */
+    index(std::vector<packed_key> keys, std::vector<std::uint32_t> offsets, std::vector<record_id> ids):
+      keys_(std::move(keys)),
+      offsets_(std::move(offsets)),
+      ids_(std::move(ids))
+    {
+    }
+
+    /* entries already sorted and distinct */
+    static index grouped(const std::vector<entry>& entries)
+    {
+      index result;
+      result.assign(entries);
+      return result;
+    }
+
+    const std::vector<packed_key>& keys() const
+    {
+      return keys_;
+    }
+
+    const std::vector<std::uint32_t>& offsets() const
+    {
+      return offsets_;
+    }
+
+    const std::vector<record_id>& ids() const
+    {
+      return ids_;
+    }
+
+    /* number of distinct keys */
+    std::size_t size() const
+    {
+      return keys_.size();
+    }
+
+    index_view view() const
+    {
+      return index_view(keys_.data(), keys_.size(), offsets_.data(), ids_.data());
+    }
+
+    /* position of key in keys(), or size() if absent */
+    std::size_t find(packed_key key) const
+    {
+      return view().find(key);
+    }
+
+    id_range postings(std::size_t position) const
+    {
+      return view().postings(position);
+    }
+
+    id_range lookup(packed_key key) const
+    {
+      return view().lookup(key);
+    }
+
+    std::pair<std::size_t, std::size_t> prefix_range(packed_key prefix, std::size_t len) const
+    {
+      return view().prefix_range(prefix, len);
+    }
+
+  private:
+    void assign(const std::vector<entry>& entries)
+    {
+      offsets_.clear();
+      ids_.reserve(entries.size());
+      for (auto& entry : entries)
+      {
+        if (keys_.empty() || keys_.back() != entry.first)
+        {
+          keys_.push_back(entry.first);
+          offsets_.push_back(std::uint32_t(ids_.size()));
+        }
+        ids_.push_back(entry.second);
+      }
+      offsets_.push_back(std::uint32_t(ids_.size()));
+    }
+
+    std::vector<packed_key> keys_;
+    std::vector<std::uint32_t> offsets_;
+    std::vector<record_id> ids_;
+  };
+
+  /* collects records under both their keys */
+  class index_builder
+  {
+  public:
+    void add(record_id id, packed_key key)
+    {
+      entries_.push_back(index::entry(key, id));
+    }
+
+    void add(record_id id, const packed_keys& keys)
+    {
+      entries_.push_back(index::entry(keys.first, id));
+      if (keys.second != keys.first)
+        entries_.push_back(index::entry(keys.second, id));
+    }
+
+    void add(record_id id, const std::string& word, const encode_limits& limits = encode_limits())
+    {
+      add(id, double_metaphone_packed(word, limits));
+    }
+
+    index build()
+    {
+      index built(std::move(entries_));
+      entries_.clear();
+      return built;
+    }
+
+  private:
+    std::vector<index::entry> entries_;
+  };
+}
+
+#endif
@@ -0,0 +1,143 @@
+//
+//  double_metaphone_interleaved.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_INTERLEAVED_H
+#define DM_DOUBLE_METAPHONE_INTERLEAVED_H
+
+#include <string>
+#include <utility>
+
+#include "double_metaphone_packed.h"
+
+namespace dm
+{
+  namespace detail
+  {
+    /* encodes words Lanes at a time, each encoder taking a turn of its main loop in round robin;
+       callbacks[lane].begin(word) precedes the parts of each word the lane takes */
+    template <std::size_t Lanes, typename C> inline void interleave(const std::string* words, std::size_t count, C* callbacks, const encode_limits& limits)
+    {
+      double_metaphone_encoder encoders[Lanes];
+      std::size_t next = 0;
+
+      /* starts lane on the next word with letters left after its start, returning whether there was one */
+      auto refill = [&](std::size_t lane)
+      {
+        while (next < count)
+        {
+          callbacks[lane].begin(next);
+          encoders[lane].start(words[next].data(), words[next].size(), callbacks[lane], limits);
+          ++next;
+          if (!encoders[lane].done())
+            return true;
+        }
+        return false;
+      };
+
+      std::size_t lanes = 0;
+      while (lanes < Lanes && refill(lanes))
+        ++lanes;
+
+      while (lanes)
+        for (std::size_t lane = 0; lane < lanes;)
+        {
+          encoders[lane].step(callbacks[lane]);
+          if (!encoders[lane].done() || refill(lane))
+            ++lane;
+          else
+          {
+            /* no words left, so the last lane moves into this one */
+            if (lane < --lanes)
+            {
+              std::swap(encoders[lane], encoders[lanes]);
+              std::swap(callbacks[lane], callbacks[lanes]);
+            }
+          }
+        }
+    }
+
+    template <typename F> struct word_callback
+    {
+      F* callback;
+      std::size_t word;
+
+      void begin(std::size_t next)
+      {
+        word = next;
+      }
+
+      void operator()(const char* metaph1, const char* metaph2, size_t start, size_t len) const
+      {
+        (*callback)(word, metaph1, metaph2, start, len);
+      }
+    };
+
+    struct packed_callback
+    {
+      packed_keys* keys;
+      packed_keys* key;
+      unsigned shift1;
+      unsigned shift2;
+
+      void begin(std::size_t next)
+      {
+        key = keys + next;
+        *key = packed_keys(0, 0);
+        shift1 = 64;
+        shift2 = 64;
+      }
+
+      void operator()(const char* metaph1, const char* metaph2, size_t, size_t)
+      {
+        pack_append(key->first, shift1, metaph1);
+        pack_append(key->second, shift2, metaph2);
+      }
+    };
+  }
+
+  /* encodes words Lanes at a time so the independent branches and loads of different words can overlap,
+     calling callback(word, metaph1, metaph2, start, len); each word's parts come in order but words mix */
+  template <std::size_t Lanes = 4, typename F> inline void double_metaphone_interleaved(const std::string* words, std::size_t count, F callback, const encode_limits& limits = encode_limits())
+  {
+    detail::word_callback<F> callbacks[Lanes];
+    for (auto& lane : callbacks)
+      lane.callback = &callback;
+    detail::interleave<Lanes>(words, count, callbacks, limits);
+  }
+
+  /* the packed keys of words, encoding Lanes words at a time */
+  template <std::size_t Lanes = 4> inline void double_metaphone_packed_interleaved(const std::string* words, std::size_t count, packed_keys* keys, const encode_limits& limits = encode_limits())
+  {
+    detail::packed_callback callbacks[Lanes];
+    for (auto& lane : callbacks)
+      lane.keys = keys;
+    detail::interleave<Lanes>(words, count, callbacks, limits);
+  }
+}
+
+#endif
@@ -0,0 +1,301 @@
+//
+//  double_metaphone_join.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_JOIN_H
+#define DM_DOUBLE_METAPHONE_JOIN_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "double_metaphone_index.h"
+#include "double_metaphone_parallel.h"
+
+namespace dm
+{
+  /* most partition bits a join takes: each thread keeps a counter per partition for each side */
+  const int max_join_partition_bits = 20;
+
+  struct join_options
+  {
+    join_options(): threads(default_threads()), partition_bits(-1), max_block_pairs(1 << 20)
+    {
+    }
+
+    unsigned threads;
+
+    /* log2 of the number of partitions, from 0 to max_join_partition_bits with larger values taken as the maximum,
+       or negative to size partitions of the right side to cache */
+    int partition_bits;
+
+    /* blocks of records sharing a key that would make more pairs than this are skipped */
+    std::size_t max_block_pairs;
+  };
+
+  struct join_result
+  {
+    /* (left, right) record positions sharing a key, each pair once */
+    std::vector<std::pair<record_id, record_id>> pairs;
+
+    std::size_t skipped_blocks;
+    std::size_t skipped_pairs;
+  };
+
+  namespace detail
+  {
+    struct join_entry
+    {
+      packed_key key;
+      packed_key other;
+      record_id id;
+
+      bool operator<(const join_entry& entry) const
+      {
+        return key < entry.key || (key == entry.key && id < entry.id);
+      }
+    };
+
+    inline std::size_t join_partition(packed_key key, unsigned bits)
+    {
+      return bits ? std::size_t((key * 0x9E3779B97F4A7C15ull) >> (64 - bits)) : 0;
+    }
+
+    /* scatters an entry per distinct key of each record into partitions by key hash,
+       returns where each partition starts in entries */
+    inline std::vector<std::size_t> partition_join_entries(const packed_keys* keys,
+                                                           std::size_t count,
+                                                           unsigned bits,
+                                                           unsigned threads,
+                                                           std::vector<join_entry>& entries)
+    {
+      const std::size_t partitions = std::size_t(1) << bits;
+      std::vector<std::size_t> cursors(threads * partitions);
+
+      parallel_for(count, threads, [&](unsigned thread, std::size_t first, std::size_t last)
+                   {
+                     auto histogram = &cursors[thread * partitions];
+                     for (auto i = first; i < last; ++i)
+                     {
+                       ++histogram[join_partition(keys[i].first, bits)];
+                       if (keys[i].second != keys[i].first)
+                         ++histogram[join_partition(keys[i].second, bits)];
+                     }
+                   });
+
+      /* each thread scatters into its own run within each partition */
+      std::vector<std::size_t> starts(partitions + 1);
+      std::size_t total = 0;
+      for (std::size_t partition = 0; partition < partitions; ++partition)
+      {
+        starts[partition] = total;
+        for (unsigned thread = 0; thread < threads; ++thread)
+        {
+          const auto size = cursors[thread * partitions + partition];
+          cursors[thread * partitions + partition] = total;
+          total += size;
+        }
+      }
+      starts[partitions] = total;
+
+      entries.resize(total);
+      parallel_for(count, threads, [&](unsigned thread, std::size_t first, std::size_t last)
+                   {
+                     auto cursor = &cursors[thread * partitions];
+                     for (auto i = first; i < last; ++i)
+                     {
+                       const join_entry entry1 = { keys[i].first, keys[i].second, record_id(i) };
+                       entries[cursor[join_partition(entry1.key, bits)]++] = entry1;
+                       if (keys[i].second != keys[i].first)
+                       {
+                         const join_entry entry2 = { keys[i].second, keys[i].first, record_id(i) };
+                         entries[cursor[join_partition(entry2.key, bits)]++] = entry2;
+                       }
+                     }
+                   });
+      return starts;
+    }
+
+    typedef std::vector<join_entry>::iterator join_iterator;
+
+    /* calls f(key, pairs, left_first, left_end, right_first, right_end) for each key on both sorted sides */
+    template <typename F>
+    void join_blocks(join_iterator left_first, join_iterator left_last,
+                     join_iterator right_first, join_iterator right_last,
+                     F f)
+    {
+      while (left_first != left_last && right_first != right_last)
+      {
+        if (left_first->key < right_first->key)
+          ++left_first;
+        else if (right_first->key < left_first->key)
+          ++right_first;
+        else
+        {
+          const auto key = left_first->key;
+          auto left_end = left_first;
+          while (left_end != left_last && left_end->key == key)
+            ++left_end;
+          auto right_end = right_first;
+          while (right_end != right_last && right_end->key == key)
+            ++right_end;
+
+          f(key, std::size_t(left_end - left_first) * std::size_t(right_end - right_first),
+            left_first, left_end, right_first, right_end);
+          left_first = left_end;
+          right_first = right_end;
+        }
+      }
+    }
+  }
+
+  /* pairs of left and right records sharing a primary or alternate key,
+     by radix partitioning both sides on key hash and joining the partitions across threads */
+  inline join_result phonetic_join(const packed_keys* left,
+                                   std::size_t left_count,
+                                   const packed_keys* right,
+                                   std::size_t right_count,
+                                   const join_options& options = join_options())
+  {
+    const unsigned threads = std::max(options.threads, 1u);
+
+    /* partitions of the right side around 16K entries, so their part of the join stays in cache */
+    unsigned bits = 0;
+    if (options.partition_bits >= 0)
+      bits = unsigned(std::min(options.partition_bits, max_join_partition_bits));
+    else
+      while (bits < 16 && (right_count >> bits) > 16384)
+        ++bits;
+
+    std::vector<detail::join_entry> left_entries;
+    std::vector<detail::join_entry> right_entries;
+    const auto left_starts = detail::partition_join_entries(left, left_count, bits, threads, left_entries);
+    const auto right_starts = detail::partition_join_entries(right, right_count, bits, threads, right_entries);
+
+    const std::size_t partitions = std::size_t(1) << bits;
+    std::vector<std::vector<std::pair<record_id, record_id>>> partition_pairs(partitions);
+    std::vector<std::size_t> skipped_blocks(threads);
+    std::vector<std::size_t> skipped_pairs(threads);
+    std::atomic<std::size_t> next(0);
+
+    /* first sort each partition and find the keys whose blocks are too big to emit */
+    std::vector<std::vector<packed_key>> skipped_keys(threads);
+    parallel_for(threads, threads, [&](unsigned thread, std::size_t, std::size_t)
+                 {
+                   for (std::size_t partition; (partition = next++) < partitions;)
+                   {
+                     auto left_first = left_entries.begin() + left_starts[partition];
+                     auto left_last = left_entries.begin() + left_starts[partition + 1];
+                     auto right_first = right_entries.begin() + right_starts[partition];
+                     auto right_last = right_entries.begin() + right_starts[partition + 1];
+                     if (left_first == left_last || right_first == right_last)
+                       continue;
+                     std::sort(left_first, left_last);
+                     std::sort(right_first, right_last);
+                     detail::join_blocks(left_first, left_last, right_first, right_last,
+                                         [&](packed_key key, std::size_t block, detail::join_iterator,
+                                             detail::join_iterator, detail::join_iterator, detail::join_iterator)
+                                         {
+                                           if (block > options.max_block_pairs)
+                                           {
+                                             ++skipped_blocks[thread];
+                                             skipped_pairs[thread] += block;
+                                             skipped_keys[thread].push_back(key);
+                                           }
+                                         });
+                   }
+                 });
+
+    std::vector<packed_key> skipped;
+    for (auto& keys : skipped_keys)
+      skipped.insert(skipped.end(), keys.begin(), keys.end());
+    std::sort(skipped.begin(), skipped.end());
+
+    next = 0;
+    parallel_for(threads, threads, [&](unsigned, std::size_t, std::size_t)
+                 {
+                   for (std::size_t partition; (partition = next++) < partitions;)
+                   {
+                     auto& pairs = partition_pairs[partition];
+                     detail::join_blocks(left_entries.begin() + left_starts[partition],
+                                         left_entries.begin() + left_starts[partition + 1],
+                                         right_entries.begin() + right_starts[partition],
+                                         right_entries.begin() + right_starts[partition + 1],
+                                         [&](packed_key key, std::size_t block,
+                                             detail::join_iterator left_first, detail::join_iterator left_end,
+                                             detail::join_iterator right_first, detail::join_iterator right_end)
+                                         {
+                                           if (block > options.max_block_pairs)
+                                             return;
+                                           for (auto l = left_first; l != left_end; ++l)
+                                             for (auto r = right_first; r != right_end; ++r)
+                                               /* when both keys match, only the lesser key emits the pair,
+                                                  unless its block was skipped */
+                                               if (!(l->other < key && l->other == r->other
+                                                     && !std::binary_search(skipped.begin(), skipped.end(), l->other)))
+                                                 pairs.push_back(std::make_pair(l->id, r->id));
+                                         });
+                   }
+                 });
+
+    join_result result;
+    result.skipped_blocks = 0;
+    result.skipped_pairs = 0;
+    for (unsigned thread = 0; thread < threads; ++thread)
+    {
+      result.skipped_blocks += skipped_blocks[thread];
+      result.skipped_pairs += skipped_pairs[thread];
+    }
+
+    std::size_t total = 0;
+    for (auto& pairs : partition_pairs)
+      total += pairs.size();
+    result.pairs.reserve(total);
+    for (auto& pairs : partition_pairs)
+      result.pairs.insert(result.pairs.end(), pairs.begin(), pairs.end());
+    return result;
+  }
+
+  /* encodes both sides across threads and joins them */
+  inline join_result phonetic_join(const std::string* left,
+                                   std::size_t left_count,
+                                   const std::string* right,
+                                   std::size_t right_count,
+                                   const join_options& options = join_options())
+  {
+    std::vector<packed_keys> left_keys(left_count);
+    std::vector<packed_keys> right_keys(right_count);
+    double_metaphone_packed(left, left_count, left_keys.data(), options.threads);
+    double_metaphone_packed(right, right_count, right_keys.data(), options.threads);
+    return phonetic_join(left_keys.data(), left_count, right_keys.data(), right_count, options);
+  }
+}
+
+#endif
@@ -0,0 +1,199 @@
+//
+//  double_metaphone_key_pair.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_KEY_PAIR_H
+#define DM_DOUBLE_METAPHONE_KEY_PAIR_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "double_metaphone.h"
+
+namespace dm
+{
+  /* primary and alternate keys held inline, 32 bytes and trivially copyable, so vectors of them are dense and memcpy-able;
+     keys past capacity symbols are truncated and flagged */
+  class key_pair
+  {
+  public:
+    enum
+    {
+      capacity = 14
+    };
+
+    key_pair()
+    {
+      std::memset(keys_, 0, sizeof(keys_));
+    }
+
+    /* null terminated */
+    const char* first() const
+    {
+      return keys_[0].symbols;
+    }
+
+    const char* second() const
+    {
+      return keys_[1].symbols;
+    }
+
+    std::size_t first_size() const
+    {
+      return keys_[0].size & size_mask;
+    }
+
+    std::size_t second_size() const
+    {
+      return keys_[1].size & size_mask;
+    }
+
+    /* whether either key was truncated */
+    bool overflowed() const
+    {
+      return ((keys_[0].size | keys_[1].size) & overflow_flag) != 0;
+    }
+
+    /* appends key parts, as the encoder calls back with them */
+    void append(const char* metaph1, const char* metaph2)
+    {
+      append(keys_[0], metaph1);
+      append(keys_[1], metaph2);
+    }
+
+    std::pair<std::string, std::string> strings() const
+    {
+      return std::make_pair(std::string(first(), first_size()), std::string(second(), second_size()));
+    }
+
+    std::size_t hash() const
+    {
+      std::uint64_t words[4];
+      std::memcpy(words, keys_, sizeof(words));
+      std::uint64_t hashed = 0;
+      for (auto word : words)
+        hashed = mix(hashed ^ word);
+      return std::size_t(hashed);
+    }
+
+    /* by first key then second, overflowed after the truncated key */
+    friend bool operator==(const key_pair& pair1, const key_pair& pair2)
+    {
+      return std::memcmp(pair1.keys_, pair2.keys_, sizeof(pair1.keys_)) == 0;
+    }
+
+    friend bool operator!=(const key_pair& pair1, const key_pair& pair2)
+    {
+      return !(pair1 == pair2);
+    }
+
+    friend bool operator<(const key_pair& pair1, const key_pair& pair2)
+    {
+      return std::memcmp(pair1.keys_, pair2.keys_, sizeof(pair1.keys_)) < 0;
+    }
+
+  private:
+    enum
+    {
+      size_mask = 0x7F,
+      overflow_flag = 0x80
+    };
+
+    /* symbols zero padded, so whole keys compare as their strings */
+    struct key
+    {
+      char symbols[capacity + 1];
+      std::uint8_t size;
+    };
+
+    static void append(key& to, const char* metaph)
+    {
+      if (!metaph)
+        return;
+      for (; *metaph; ++metaph)
+        if ((to.size & size_mask) < capacity)
+          to.symbols[to.size++] = *metaph;
+        else
+          to.size |= overflow_flag;
+    }
+
+    /* murmur3 finalizer */
+    static std::uint64_t mix(std::uint64_t word)
+    {
+      word ^= word >> 33;
+      word *= 0xFF51AFD7ED558CCDull;
+      word ^= word >> 33;
+      word *= 0xC4CEB9FE1A85EC53ull;
+      word ^= word >> 33;
+      return word;
+    }
+
+    key keys_[2];
+  };
+
+  static_assert(sizeof(key_pair) == 32, "key_pair should pack two keys into 32 bytes");
+  /* libstdc++ before gcc 5 lacks is_trivially_copyable, whichever compiler uses it; clang claims __GNUC__ 4 but has the
+     builtin, gcc before 5 only the older traits */
+#if defined(__clang__)
+  static_assert(__is_trivially_copyable(key_pair), "key_pair should be trivially copyable");
+#elif defined(__GLIBCXX__) && defined(__GNUC__) && __GNUC__ < 5
+  static_assert(__has_trivial_copy(key_pair) && __has_trivial_assign(key_pair) && __has_trivial_destructor(key_pair),
+                "key_pair should be trivially copyable");
+#else
+  static_assert(std::is_trivially_copyable<key_pair>::value, "key_pair should be trivially copyable");
+#endif
+
+  /* fills the pair from the encoder callbacks, never composing strings */
+  inline key_pair double_metaphone_key_pair(const std::string& str, const encode_limits& limits = encode_limits())
+  {
+    key_pair result;
+    double_metaphone(str.data(), str.size(),
+                     [&result](const char* metaph1, const char* metaph2, size_t start, size_t len)
+                     {
+                       result.append(metaph1, metaph2);
+                     },
+                     limits);
+    return result;
+  }
+}
+
+namespace std
+{
+  template <> struct hash<dm::key_pair>
+  {
+    std::size_t operator()(const dm::key_pair& pair) const
+    {
+      return pair.hash();
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,479 @@
+//
+//  double_metaphone_live_index.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_LIVE_INDEX_H
+#define DM_DOUBLE_METAPHONE_LIVE_INDEX_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "double_metaphone_index.h"
+
+namespace dm
+{
+  /* a key added to or removed from a record */
+  struct index_change
+  {
+    index::entry entry;
+    bool insert;
+  };
+
+  /* an index taking inserts and deletes while being read: readers never lock, they announce an epoch
+     and read an immutable snapshot of base index plus sorted delta; writers publish new snapshots and
+     free the old ones once no reader can be in them. A background thread compacts the delta into a new
+     base when it grows past the threshold.
+
+     The delta is a few immutable sorted chunks shared between snapshots, each at most half the size of
+     the one before, the newest deciding an entry; a write adds a chunk and merges the smaller ones into it,
+     so it copies O(log delta) entries amortized rather than the whole delta. */
+  class live_index
+  {
+  public:
+    class reader;
+
+    explicit live_index(index base = index(), std::size_t compaction_threshold = 65536):
+      compaction_threshold_(compaction_threshold),
+      epoch_(1),
+      stopping_(false)
+    {
+      auto initial = new snapshot();
+      initial->base = std::make_shared<const index>(std::move(base));
+      current_.store(initial);
+      for (auto& slot : slots_)
+      {
+        slot.claimed.store(false);
+        slot.epoch.store(0);
+      }
+      compactor_ = std::thread([this] { compact_when_needed(); });
+    }
+
+    live_index(const live_index&) = delete;
+    live_index& operator=(const live_index&) = delete;
+
+    ~live_index()
+    {
+      {
+        std::lock_guard<std::mutex> lock(writer_);
+        stopping_ = true;
+      }
+      grown_.notify_one();
+      compactor_.join();
+
+      /* readers must be gone by now */
+      for (auto& retired : retired_)
+        delete retired.second;
+      delete current_.load();
+    }
+
+    void insert(record_id id, const packed_keys& keys)
+    {
+      apply(changes(id, keys, true));
+    }
+
+    void erase(record_id id, const packed_keys& keys)
+    {
+      apply(changes(id, keys, false));
+    }
+
+    /* applies changes in order as one new snapshot */
+    void apply(const std::vector<index_change>& changes)
+    {
+      std::unique_lock<std::mutex> lock(writer_);
+      const snapshot* old = current_.load();
+      auto updated = new snapshot(*old);
+      updated->change(changes);
+      publish(updated);
+
+      if (updated->size >= compaction_threshold_)
+      {
+        lock.unlock();
+        grown_.notify_one();
+      }
+    }
+
+    /* merges the delta into a new base index; writes carry on meanwhile */
+    void compact()
+    {
+      std::unique_lock<std::mutex> lock(compacting_);
+      std::shared_ptr<const index> base;
+      std::vector<std::shared_ptr<const chunk>> chunks;
+      {
+        std::lock_guard<std::mutex> writing(writer_);
+        const snapshot* current = current_.load();
+        base = current->base;
+        chunks = current->chunks;
+      }
+      if (chunks.empty())
+        return;
+
+      /* base with the delta, built without holding up writers */
+      chunk delta = *chunks[0];
+      for (std::size_t i = 1; i < chunks.size(); ++i)
+        delta = snapshot::merged(delta, *chunks[i]);
+      std::vector<index::entry> entries;
+      entries.reserve(base->ids().size() + delta.size());
+      for (std::size_t position = 0; position < base->size(); ++position)
+        for (auto id : base->postings(position))
+        {
+          const index::entry entry(base->keys()[position], id);
+          const auto changed = std::lower_bound(delta.begin(), delta.end(), entry, snapshot::before);
+          if (changed == delta.end() || changed->entry != entry || changed->insert)
+            entries.push_back(entry);
+        }
+      std::vector<index::entry> inserts;
+      for (auto& change : delta)
+        if (change.insert && !snapshot::base_contains(*base, change.entry))
+          inserts.push_back(change.entry);
+      std::vector<index::entry> merged;
+      merged.reserve(entries.size() + inserts.size());
+      std::merge(entries.begin(), entries.end(), inserts.begin(), inserts.end(), std::back_inserter(merged));
+      auto compacted = std::make_shared<const index>(index::grouped(merged));
+
+      /* rebase whatever delta the writers have made since onto the compacted base */
+      std::lock_guard<std::mutex> writing(writer_);
+      const snapshot* current = current_.load();
+      std::vector<index::entry> touched;
+      touched.reserve(delta.size() + current->size);
+      for (auto& change : delta)
+        touched.push_back(change.entry);
+      for (auto& changes : current->chunks)
+        for (auto& change : *changes)
+          touched.push_back(change.entry);
+      std::sort(touched.begin(), touched.end());
+      touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+      auto rebased = new snapshot();
+      rebased->base = compacted;
+      auto changes = std::make_shared<chunk>();
+      for (auto& entry : touched)
+      {
+        const bool wanted = current->contains(entry);
+        if (wanted != snapshot::base_contains(*compacted, entry))
+          changes->push_back(index_change { entry, wanted });
+      }
+      if (!changes->empty())
+      {
+        rebased->size = changes->size();
+        rebased->chunks.push_back(std::move(changes));
+      }
+      publish(rebased);
+    }
+
+    /* delta entries not yet compacted */
+    std::size_t delta_size() const
+    {
+      std::lock_guard<std::mutex> lock(writer_);
+      return current_.load()->size;
+    }
+
+  private:
+    /* changes sorted by entry, each entry once */
+    typedef std::vector<index_change> chunk;
+
+    struct snapshot
+    {
+      snapshot(): size(0)
+      {
+      }
+
+      std::shared_ptr<const index> base;
+
+      /* oldest first */
+      std::vector<std::shared_ptr<const chunk>> chunks;
+
+      /* entries in all the chunks */
+      std::size_t size;
+
+      static bool before(const index_change& change, const index::entry& entry)
+      {
+        return change.entry < entry;
+      }
+
+      static bool base_contains(const index& base, const index::entry& entry)
+      {
+        const auto ids = base.lookup(entry.first);
+        return std::binary_search(ids.begin(), ids.end(), entry.second);
+      }
+
+      /* the changes of both, newer's winning */
+      static chunk merged(const chunk& older, const chunk& newer)
+      {
+        chunk result;
+        result.reserve(older.size() + newer.size());
+        auto next_older = older.begin();
+        auto next_newer = newer.begin();
+        while (next_older != older.end() || next_newer != newer.end())
+          if (next_newer == newer.end() || (next_older != older.end() && next_older->entry < next_newer->entry))
+            result.push_back(*next_older++);
+          else
+          {
+            if (next_older != older.end() && next_older->entry == next_newer->entry)
+              ++next_older;
+            result.push_back(*next_newer++);
+          }
+        return result;
+      }
+
+      bool contains(const index::entry& entry) const
+      {
+        for (auto changes = chunks.rbegin(); changes != chunks.rend(); ++changes)
+        {
+          const auto changed = std::lower_bound((*changes)->begin(), (*changes)->end(), entry, before);
+          if (changed != (*changes)->end() && changed->entry == entry)
+            return changed->insert;
+        }
+        return base_contains(*base, entry);
+      }
+
+      /* adds the changes that make a difference as a new chunk, then merges it down while no smaller than the one before */
+      void change(const std::vector<index_change>& changes)
+      {
+        chunk added(changes);
+        std::stable_sort(added.begin(), added.end(), [](const index_change& change1, const index_change& change2)
+                         {
+                           return change1.entry < change2.entry;
+                         });
+
+        /* the last change of each entry, if it differs from what's there */
+        auto kept = added.begin();
+        for (auto change = added.begin(); change != added.end(); ++change)
+          if ((change + 1 == added.end() || change[1].entry != change->entry) && contains(change->entry) != change->insert)
+            *kept++ = *change;
+        added.erase(kept, added.end());
+        if (added.empty())
+          return;
+
+        size += added.size();
+        while (!chunks.empty() && chunks.back()->size() <= 2 * added.size())
+        {
+          size -= chunks.back()->size() + added.size();
+          added = merged(*chunks.back(), added);
+          chunks.pop_back();
+
+          /* at the bottom nothing older hides the base, so changes back to it can go */
+          if (chunks.empty())
+            added.erase(std::remove_if(added.begin(), added.end(), [this](const index_change& change)
+                                       {
+                                         return base_contains(*base, change.entry) == change.insert;
+                                       }),
+                        added.end());
+          size += added.size();
+        }
+        if (!added.empty())
+          chunks.push_back(std::make_shared<const chunk>(std::move(added)));
+      }
+
+      /* appends the ascending ids having key */
+      void lookup(packed_key key, std::vector<record_id>& ids) const
+      {
+        const auto start = ids.size();
+        const auto based = base->lookup(key);
+        ids.insert(ids.end(), based.begin(), based.end());
+
+        /* each chunk touching key in turn, oldest first */
+        for (auto& changes : chunks)
+        {
+          auto changed = std::lower_bound(changes->begin(), changes->end(), index::entry(key, 0), before);
+          auto end = changed;
+          while (end != changes->end() && end->entry.first == key)
+            ++end;
+          if (changed == end)
+            continue;
+
+          auto kept = ids.begin() + start;
+          auto deleted = changed;
+          for (auto id = kept; id != ids.end(); ++id)
+          {
+            while (deleted != end && deleted->entry.second < *id)
+              ++deleted;
+            if (deleted == end || deleted->entry.second != *id || deleted->insert)
+              *kept++ = *id;
+          }
+          ids.erase(kept, ids.end());
+
+          const auto middle = ids.size();
+          for (; changed != end; ++changed)
+            if (changed->insert)
+              ids.push_back(changed->entry.second);
+          std::inplace_merge(ids.begin() + start, ids.begin() + middle, ids.end());
+          ids.erase(std::unique(ids.begin() + start, ids.end()), ids.end());
+        }
+      }
+    };
+
+    /* per reader epoch announcement, a cache line each */
+    struct alignas(64) slot
+    {
+      std::atomic<bool> claimed;
+      std::atomic<std::uint64_t> epoch;
+    };
+
+    static const std::size_t slot_count = 256;
+
+    static std::vector<index_change> changes(record_id id, const packed_keys& keys, bool insert)
+    {
+      std::vector<index_change> changed(1, index_change { index::entry(keys.first, id), insert });
+      if (keys.second != keys.first)
+        changed.push_back(index_change { index::entry(keys.second, id), insert });
+      return changed;
+    }
+
+    /* with the writer lock: swaps in the snapshot, retires the old one and frees what no reader can see */
+    void publish(snapshot* published)
+    {
+      const snapshot* old = current_.exchange(published);
+      retired_.push_back(std::make_pair(epoch_.fetch_add(1), old));
+
+      std::uint64_t oldest = ~std::uint64_t(0);
+      for (auto& reading : slots_)
+      {
+        const auto epoch = reading.epoch.load();
+        if (epoch)
+          oldest = std::min(oldest, epoch);
+      }
+      auto kept = std::remove_if(retired_.begin(), retired_.end(), [oldest](const std::pair<std::uint64_t, const snapshot*>& retired)
+                                 {
+                                   if (retired.first >= oldest)
+                                     return false;
+                                   delete retired.second;
+                                   return true;
+                                 });
+      retired_.erase(kept, retired_.end());
+    }
+
+    void compact_when_needed()
+    {
+      for (;;)
+      {
+        {
+          std::unique_lock<std::mutex> lock(writer_);
+          grown_.wait(lock, [this]
+                      {
+                        return stopping_ || current_.load()->size >= compaction_threshold_;
+                      });
+          if (stopping_)
+            return;
+        }
+        compact();
+      }
+    }
+
+    const std::size_t compaction_threshold_;
+    std::atomic<const snapshot*> current_;
+    std::atomic<std::uint64_t> epoch_;
+    slot slots_[slot_count];
+
+    mutable std::mutex writer_;
+    std::mutex compacting_;
+    std::condition_variable grown_;
+    std::vector<std::pair<std::uint64_t, const snapshot*>> retired_;
+    bool stopping_;
+    std::thread compactor_;
+  };
+
+  /* a reading thread's handle on a live index, claiming an epoch slot for its lifetime; lookups never lock */
+  class live_index::reader
+  {
+  public:
+    explicit reader(live_index& index): index_(&index), slot_(nullptr)
+    {
+      for (auto& slot : index.slots_)
+      {
+        bool claimed = false;
+        if (slot.claimed.compare_exchange_strong(claimed, true))
+        {
+          slot_ = &slot;
+          return;
+        }
+      }
+      throw std::runtime_error("double_metaphone: too many live index readers");
+    }
+
+    reader(const reader&) = delete;
+    reader& operator=(const reader&) = delete;
+
+    ~reader()
+    {
+      slot_->claimed.store(false);
+    }
+
+    /* appends the ascending ids having key */
+    void lookup(packed_key key, std::vector<record_id>& ids)
+    {
+      pin pinned(*this);
+      pinned.current->lookup(key, ids);
+    }
+
+    /* appends the ascending ids having either key */
+    void lookup(const packed_keys& keys, std::vector<record_id>& ids)
+    {
+      pin pinned(*this);
+      const auto start = ids.size();
+      pinned.current->lookup(keys.first, ids);
+      if (keys.second != keys.first)
+      {
+        const auto middle = ids.size();
+        pinned.current->lookup(keys.second, ids);
+        std::inplace_merge(ids.begin() + start, ids.begin() + middle, ids.end());
+        ids.erase(std::unique(ids.begin() + start, ids.end()), ids.end());
+      }
+    }
+
+  private:
+    /* announces the epoch before loading the snapshot, so writers won't free it while pinned */
+    struct pin
+    {
+      explicit pin(reader& pinning): slot(pinning.slot_)
+      {
+        slot->epoch.store(pinning.index_->epoch_.load());
+        current = pinning.index_->current_.load();
+      }
+
+      ~pin()
+      {
+        slot->epoch.store(0, std::memory_order_release);
+      }
+
+      live_index::slot* slot;
+      const live_index::snapshot* current;
+    };
+
+    live_index* index_;
+    live_index::slot* slot_;
+  };
+}
+
+#endif
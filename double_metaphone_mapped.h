@@ -0,0 +1,191 @@
+//
+//  double_metaphone_mapped.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_MAPPED_H
+#define DM_DOUBLE_METAPHONE_MAPPED_H
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "double_metaphone_index.h"
+
+namespace dm
+{
+  /* index file layout, in native byte order: this header, then keys, offsets and ids */
+  struct index_file_header
+  {
+    char magic[8];
+    std::uint64_t keys;
+    std::uint64_t ids;
+  };
+
+  namespace detail
+  {
+    const char index_file_magic[8] = { 'D', 'M', 'I', 'N', 'D', 'E', 'X', '1' };
+
+    /* takes count parts of size bytes from the left bytes of a file, false if they don't fit;
+       checked before multiplying so a crafted header can't overflow */
+    inline bool take_part(std::size_t& left, std::uint64_t count, std::size_t size)
+    {
+      if (count > left / size)
+        return false;
+      left -= std::size_t(count) * size;
+      return true;
+    }
+
+    /* offsets from 0 up to end, never going back */
+    inline bool ascending_offsets(const std::uint32_t* offsets, std::size_t size, std::uint64_t end)
+    {
+      if (offsets[0] != 0 || offsets[size] != end)
+        return false;
+      for (std::size_t i = 0; i < size; ++i)
+        if (offsets[i] > offsets[i + 1])
+          return false;
+      return true;
+    }
+
+    /* maps a whole file read only, unmapping it when destroyed */
+    class mapped_file
+    {
+    public:
+      mapped_file(const std::string& path, const char* what): data_(nullptr), size_(0)
+      {
+        const int file = ::open(path.c_str(), O_RDONLY);
+        struct stat status;
+        if (file < 0 || ::fstat(file, &status) != 0)
+        {
+          if (file >= 0)
+            ::close(file);
+          throw std::runtime_error(std::string("double_metaphone: can't open ") + what + " " + path);
+        }
+
+        size_ = std::size_t(status.st_size);
+        void* data = size_ ? ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, file, 0) : MAP_FAILED;
+        ::close(file);
+        if (data == MAP_FAILED)
+          throw std::runtime_error(std::string("double_metaphone: can't map ") + what + " " + path);
+        data_ = static_cast<const char*>(data);
+      }
+
+      mapped_file(const mapped_file&) = delete;
+      mapped_file& operator=(const mapped_file&) = delete;
+
+      ~mapped_file()
+      {
+        ::munmap(const_cast<char*>(data_), size_);
+      }
+
+      const char* data() const
+      {
+        return data_;
+      }
+
+      std::size_t size() const
+      {
+        return size_;
+      }
+
+    private:
+      const char* data_;
+      std::size_t size_;
+    };
+  }
+
+  inline void write_index(const index_view& index, const std::string& path)
+  {
+    index_file_header header;
+    std::memcpy(header.magic, detail::index_file_magic, sizeof(header.magic));
+    header.keys = index.size();
+    header.ids = index.offsets()[index.size()];
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    bool written = file
+      && std::fwrite(&header, sizeof(header), 1, file) == 1
+      && std::fwrite(index.keys(), sizeof(packed_key), header.keys, file) == header.keys
+      && std::fwrite(index.offsets(), sizeof(std::uint32_t), header.keys + 1, file) == header.keys + 1
+      && std::fwrite(index.ids(), sizeof(record_id), header.ids, file) == header.ids;
+    if (file)
+      written = std::fclose(file) == 0 && written;
+    if (!written)
+      throw std::runtime_error("double_metaphone: can't write index " + path);
+  }
+
+  /* an index file mapped read only, shared with every other process mapping it */
+  class mapped_index
+  {
+  public:
+    explicit mapped_index(const std::string& path): file_(path, "index")
+    {
+      index_file_header header;
+      if (file_.size() < sizeof(header))
+        throw std::runtime_error("double_metaphone: not an index " + path);
+      std::memcpy(&header, file_.data(), sizeof(header));
+
+      std::size_t left = file_.size() - sizeof(header);
+      if (std::memcmp(header.magic, detail::index_file_magic, sizeof(header.magic)) != 0
+          || !detail::take_part(left, header.keys, sizeof(packed_key))
+          || !detail::take_part(left, header.keys + 1, sizeof(std::uint32_t))
+          || !detail::take_part(left, header.ids, sizeof(record_id))
+          || left != 0)
+        throw std::runtime_error("double_metaphone: not an index " + path);
+
+      const char* keys = file_.data() + sizeof(header);
+      const char* offsets = keys + header.keys * sizeof(packed_key);
+      const char* ids = offsets + (header.keys + 1) * sizeof(std::uint32_t);
+      keys_ = reinterpret_cast<const packed_key*>(keys);
+      offsets_ = reinterpret_cast<const std::uint32_t*>(offsets);
+      ids_ = reinterpret_cast<const record_id*>(ids);
+      keys_size_ = std::size_t(header.keys);
+
+      /* postings must stay inside the ids */
+      if (!detail::ascending_offsets(offsets_, keys_size_, header.ids))
+        throw std::runtime_error("double_metaphone: corrupt index " + path);
+    }
+
+    index_view view() const
+    {
+      return index_view(keys_, keys_size_, offsets_, ids_);
+    }
+
+  private:
+    detail::mapped_file file_;
+    const packed_key* keys_;
+    std::size_t keys_size_;
+    const std::uint32_t* offsets_;
+    const record_id* ids_;
+  };
+}
+
+#endif
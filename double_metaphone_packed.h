@@ -0,0 +1,171 @@
+//
+//  double_metaphone_packed.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_PACKED_H
+#define DM_DOUBLE_METAPHONE_PACKED_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "double_metaphone.h"
+
+namespace dm
+{
+  /* a key packed 4 bits per symbol, first symbol in the top nibble, unused nibbles zero;
+     symbol codes follow ASCII order so packed keys sort like their strings */
+  typedef std::uint64_t packed_key;
+  typedef std::pair<packed_key, packed_key> packed_keys;
+
+  /* longer keys are truncated when packed */
+  const std::size_t packed_key_capacity = 16;
+
+  namespace detail
+  {
+    inline unsigned packed_code(char ch)
+    {
+      switch (ch)
+      {
+        case '0': return 1;
+        case 'A': return 2;
+        case 'F': return 3;
+        case 'H': return 4;
+        case 'J': return 5;
+        case 'K': return 6;
+        case 'L': return 7;
+        case 'M': return 8;
+        case 'N': return 9;
+        case 'P': return 10;
+        case 'R': return 11;
+        case 'S': return 12;
+        case 'T': return 13;
+        case 'X': return 14;
+        default: return 0;
+      }
+    }
+
+    inline char packed_symbol(unsigned code)
+    {
+      return "\0" "0AFHJKLMNPRSTX"[code & 0xF];
+    }
+
+    /* appends the symbols of a key part at the nibble below shift */
+    inline void pack_append(packed_key& key, unsigned& shift, const char* metaph)
+    {
+      if (metaph)
+        for (; *metaph && shift; ++metaph)
+        {
+          shift -= 4;
+          key |= packed_key(packed_code(*metaph)) << shift;
+        }
+    }
+  }
+
+  inline packed_key pack_key(const char* key, std::size_t len)
+  {
+    packed_key packed = 0;
+    unsigned shift = 64;
+    for (std::size_t i = 0; i < len && shift; ++i)
+    {
+      shift -= 4;
+      packed |= packed_key(detail::packed_code(key[i])) << shift;
+    }
+    return packed;
+  }
+
+  inline packed_key pack_key(const std::string& key)
+  {
+    return pack_key(key.data(), key.length());
+  }
+
+  inline std::size_t packed_length(packed_key key)
+  {
+    std::size_t len = 0;
+    for (; key; key <<= 4)
+      ++len;
+    return len;
+  }
+
+  inline std::string unpack_key(packed_key key)
+  {
+    std::string result;
+    for (; key; key <<= 4)
+      result += detail::packed_symbol(unsigned(key >> 60));
+    return result;
+  }
+
+  /* mask selecting the first len symbols */
+  inline packed_key packed_prefix_mask(std::size_t len)
+  {
+    return len >= packed_key_capacity ? ~packed_key(0) : ~(~packed_key(0) >> (len * 4));
+  }
+
+  namespace detail
+  {
+    struct packed_keys_callback
+    {
+      packed_keys result;
+      unsigned shift1;
+      unsigned shift2;
+
+      packed_keys_callback(): result(0, 0), shift1(64), shift2(64)
+      {
+      }
+
+      void operator()(const char* metaph1, const char* metaph2, size_t start, size_t len)
+      {
+        pack_append(result.first, shift1, metaph1);
+        pack_append(result.second, shift2, metaph2);
+      }
+
+      /* the rest of the word can't change keys already at capacity */
+      bool full() const
+      {
+        return !shift1 && !shift2;
+      }
+    };
+  }
+
+  inline packed_keys double_metaphone_packed(const char* word, std::size_t size, const encode_limits& limits = encode_limits())
+  {
+    // pack results from callback without composing strings, stopping once both keys are full
+    double_metaphone_encoder encoder;
+    detail::packed_keys_callback callback;
+    encoder.start(word, size, callback, limits);
+    while (!encoder.done() && !callback.full())
+      encoder.step(callback);
+    return callback.result;
+  }
+
+  inline packed_keys double_metaphone_packed(const std::string& str, const encode_limits& limits = encode_limits())
+  {
+    return double_metaphone_packed(str.data(), str.size(), limits);
+  }
+}
+
+#endif
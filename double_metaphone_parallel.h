@@ -0,0 +1,78 @@
+//
+//  double_metaphone_parallel.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_PARALLEL_H
+#define DM_DOUBLE_METAPHONE_PARALLEL_H
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "double_metaphone_packed.h"
+
+namespace dm
+{
+  inline unsigned default_threads()
+  {
+    const unsigned threads = std::thread::hardware_concurrency();
+    return threads ? threads : 1;
+  }
+
+  /* calls fn(thread, first, last) for contiguous slices of [0, count), the same slices for the same count and threads */
+  template <typename F> inline void parallel_for(std::size_t count, unsigned threads, F fn)
+  {
+    if (!threads)
+      threads = 1;
+    if (threads == 1 || count < threads)
+    {
+      for (unsigned thread = 0; thread < threads; ++thread)
+        fn(thread, count * thread / threads, count * (thread + 1) / threads);
+      return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned thread = 1; thread < threads; ++thread)
+      workers.push_back(std::thread(fn, thread, count * thread / threads, count * (thread + 1) / threads));
+    fn(0u, std::size_t(0), count / threads);
+    for (auto& worker : workers)
+      worker.join();
+  }
+
+  /* packed keys of words encoded across threads */
+  inline void double_metaphone_packed(const std::string* words, std::size_t count, packed_keys* keys, unsigned threads = default_threads())
+  {
+    parallel_for(count, threads, [=](unsigned thread, std::size_t first, std::size_t last)
+                 {
+                   for (auto i = first; i < last; ++i)
+                     keys[i] = double_metaphone_packed(words[i]);
+                 });
+  }
+}
+
+#endif
@@ -0,0 +1,172 @@
+//
+//  double_metaphone_parts.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_PARTS_H
+#define DM_DOUBLE_METAPHONE_PARTS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "double_metaphone_packed.h"
+
+namespace dm
+{
+  /* one callback's worth of a key: the primary and alternate symbols of the input bytes start up to start + len,
+     each code holding up to 2 symbols packed like a key, first in the top nibble, 0 for none */
+  struct key_part
+  {
+    std::uint8_t code1;
+    std::uint8_t code2;
+    std::uint16_t len;
+    std::uint32_t start;
+  };
+
+  inline bool operator==(const key_part& part1, const key_part& part2)
+  {
+    return part1.code1 == part2.code1 && part1.code2 == part2.code2 && part1.len == part2.len && part1.start == part2.start;
+  }
+
+  inline bool operator!=(const key_part& part1, const key_part& part2)
+  {
+    return !(part1 == part2);
+  }
+
+  /* parts delivered in one call, more if a word has more */
+  const std::size_t key_part_batch = 64;
+
+  namespace detail
+  {
+    /* a callback's symbols are at most 2 */
+    inline std::uint8_t part_code(const char* metaph)
+    {
+      if (!metaph || !metaph[0])
+        return 0;
+      return std::uint8_t(packed_code(metaph[0]) << 4 | packed_code(metaph[1]));
+    }
+
+    inline key_part make_part(const char* metaph1, const char* metaph2, size_t start, size_t len)
+    {
+      key_part part;
+      part.code1 = part_code(metaph1);
+      part.code2 = part_code(metaph2);
+      part.len = std::uint16_t(len);
+      part.start = std::uint32_t(start);
+      return part;
+    }
+  }
+
+  /* the symbols of a part code */
+  inline std::string part_symbols(std::uint8_t code)
+  {
+    return unpack_key(packed_key(code) << 56);
+  }
+
+  /* appends the symbols of a part code at the nibble below shift, as when packing keys */
+  inline void pack_part(packed_key& key, unsigned& shift, std::uint8_t code)
+  {
+    for (; code && shift; code <<= 4)
+    {
+      shift -= 4;
+      key |= packed_key(code >> 4) << shift;
+    }
+  }
+
+  /* calls callback(parts, count) with the parts of a word in batches instead of once a part,
+     which pays when callback is not inlined, e.g. a std::function across a library boundary */
+  template <typename F> inline void double_metaphone_parts(const std::string& str, F callback, const encode_limits& limits = encode_limits())
+  {
+    key_part parts[key_part_batch];
+    std::size_t count = 0;
+    double_metaphone(str,
+                     [&](const char* metaph1, const char* metaph2, size_t start, size_t len)
+                     {
+                       if (count == key_part_batch)
+                       {
+                         callback(static_cast<const key_part*>(parts), count);
+                         count = 0;
+                       }
+                       parts[count++] = detail::make_part(metaph1, metaph2, start, len);
+                     },
+                     limits);
+    if (count)
+      callback(static_cast<const key_part*>(parts), count);
+  }
+
+  /* calls callback(first, words, ends, parts) with the parts of many words in batches: word first + i has parts from
+     ends[i - 1], or 0 for the first, up to ends[i]; a word with more parts than a batch holds spans consecutive calls */
+  template <typename F> inline void double_metaphone_parts(const std::string* words, std::size_t count, F callback, const encode_limits& limits = encode_limits())
+  {
+    key_part parts[key_part_batch];
+    std::uint32_t ends[key_part_batch];
+    std::size_t first = 0;
+    std::size_t parts_count = 0;
+    std::size_t words_count = 0;
+
+    auto flush = [&]()
+    {
+      callback(first, words_count, static_cast<const std::uint32_t*>(ends), static_cast<const key_part*>(parts));
+      const std::size_t done = ends[words_count - 1];
+      std::copy(parts + done, parts + parts_count, parts);
+      parts_count -= done;
+      words_count = 0;
+    };
+
+    for (std::size_t word = 0; word < count; ++word)
+    {
+      if (words_count == 0)
+        first = word;
+      double_metaphone(words[word],
+                       [&](const char* metaph1, const char* metaph2, size_t start, size_t len)
+                       {
+                         if (parts_count == key_part_batch)
+                         {
+                           /* the words done so far, then if still full this word's parts so far */
+                           if (words_count)
+                             flush();
+                           first = word;
+                           if (parts_count == key_part_batch)
+                           {
+                             ends[words_count++] = std::uint32_t(parts_count);
+                             flush();
+                           }
+                         }
+                         parts[parts_count++] = detail::make_part(metaph1, metaph2, start, len);
+                       },
+                       limits);
+      ends[words_count++] = std::uint32_t(parts_count);
+      if (words_count == key_part_batch)
+        flush();
+    }
+    if (words_count)
+      flush();
+  }
+}
+
+#endif
@@ -0,0 +1,444 @@
+//
+//  double_metaphone_postings.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_POSTINGS_H
+#define DM_DOUBLE_METAPHONE_POSTINGS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "double_metaphone_index.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DM_POSTINGS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace dm
+{
+  namespace detail
+  {
+    /* Stream VByte: a control byte holds the byte lengths of 4 deltas, the deltas follow in data bytes */
+
+    inline unsigned vbyte_code(std::uint32_t value)
+    {
+      return value < (1u << 8) ? 0 : value < (1u << 16) ? 1 : value < (1u << 24) ? 2 : 3;
+    }
+
+    inline void vbyte_encode(const record_id* ids, std::size_t count, std::vector<std::uint8_t>& bytes)
+    {
+      const std::size_t controls = bytes.size();
+      bytes.resize(controls + (count + 3) / 4);
+      record_id previous = 0;
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        const std::uint32_t delta = ids[i] - previous;
+        previous = ids[i];
+        const unsigned code = vbyte_code(delta);
+        bytes[controls + i / 4] |= std::uint8_t(code << ((i % 4) * 2));
+        for (unsigned byte = 0; byte <= code; ++byte)
+          bytes.push_back(std::uint8_t(delta >> (byte * 8)));
+      }
+    }
+
+    /* decodes from group onwards, for the tail of the vector decoder */
+    inline void vbyte_decode_scalar(const std::uint8_t* controls, const std::uint8_t* data, std::size_t count, std::size_t from, record_id previous, record_id* ids)
+    {
+      for (std::size_t i = from; i < count; ++i)
+      {
+        const unsigned code = (controls[i / 4] >> ((i % 4) * 2)) & 3;
+        std::uint32_t delta = 0;
+        for (unsigned byte = 0; byte <= code; ++byte)
+          delta |= std::uint32_t(*data++) << (byte * 8);
+        ids[i] = previous += delta;
+      }
+    }
+
+    /* per control byte, the shuffle spreading its data bytes over 4 lanes and the bytes it uses */
+    struct vbyte_tables
+    {
+      std::uint8_t shuffles[256][16];
+      std::uint8_t lengths[256];
+
+      vbyte_tables()
+      {
+        for (unsigned control = 0; control < 256; ++control)
+        {
+          unsigned length = 0;
+          for (unsigned lane = 0; lane < 4; ++lane)
+          {
+            const unsigned code = (control >> (lane * 2)) & 3;
+            for (unsigned byte = 0; byte < 4; ++byte)
+              shuffles[control][lane * 4 + byte] = byte <= code ? std::uint8_t(length + byte) : 0x80;
+            length += code + 1;
+          }
+          lengths[control] = std::uint8_t(length);
+        }
+      }
+    };
+
+    /* per 4 bit mask, the shuffle packing the selected lanes to the front */
+    struct compact_tables
+    {
+      std::uint8_t shuffles[16][16];
+
+      compact_tables()
+      {
+        for (unsigned mask = 0; mask < 16; ++mask)
+        {
+          unsigned out = 0;
+          for (unsigned lane = 0; lane < 4; ++lane)
+            if (mask & (1u << lane))
+            {
+              for (unsigned byte = 0; byte < 4; ++byte)
+                shuffles[mask][out * 4 + byte] = std::uint8_t(lane * 4 + byte);
+              ++out;
+            }
+          for (; out < 4; ++out)
+            for (unsigned byte = 0; byte < 4; ++byte)
+              shuffles[mask][out * 4 + byte] = 0x80;
+        }
+      }
+    };
+
+    inline const vbyte_tables& vbyte_table()
+    {
+      static const vbyte_tables tables;
+      return tables;
+    }
+
+    inline const compact_tables& compact_table()
+    {
+      static const compact_tables tables;
+      return tables;
+    }
+
+    inline std::size_t intersect_scalar(const record_id* a, std::size_t a_count, const record_id* b, std::size_t b_count, record_id* out)
+    {
+      return std::set_intersection(a, a + a_count, b, b + b_count, out) - out;
+    }
+
+    /* merges without repeating last, the last id already written if any */
+    inline std::size_t unite_scalar(const record_id* a, std::size_t a_count, const record_id* b, std::size_t b_count, record_id* out, std::size_t written)
+    {
+      std::size_t i = 0;
+      std::size_t j = 0;
+      while (i < a_count || j < b_count)
+      {
+        record_id next;
+        if (j == b_count || (i < a_count && a[i] < b[j]))
+          next = a[i++];
+        else
+        {
+          if (i < a_count && a[i] == b[j])
+            ++i;
+          next = b[j++];
+        }
+        if (!written || out[written - 1] != next)
+          out[written++] = next;
+      }
+      return written;
+    }
+
+#ifdef DM_POSTINGS_X86
+    /* out needs 16 bytes beyond count; data needs 16 readable bytes beyond its end */
+    __attribute__((target("ssse3")))
+    inline void vbyte_decode_ssse3(const std::uint8_t* controls, const std::uint8_t* data, std::size_t count, record_id* ids)
+    {
+      const auto& tables = vbyte_table();
+      __m128i previous = _mm_setzero_si128();
+      const std::size_t groups = count / 4;
+      for (std::size_t group = 0; group < groups; ++group)
+      {
+        const std::uint8_t control = controls[group];
+        __m128i deltas = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)),
+                                          _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.shuffles[control])));
+        data += tables.lengths[control];
+
+        /* prefix sum across the lanes, carrying on from the previous group */
+        deltas = _mm_add_epi32(deltas, _mm_slli_si128(deltas, 4));
+        deltas = _mm_add_epi32(deltas, _mm_slli_si128(deltas, 8));
+        previous = _mm_add_epi32(deltas, _mm_shuffle_epi32(previous, _MM_SHUFFLE(3, 3, 3, 3)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(ids + group * 4), previous);
+      }
+      vbyte_decode_scalar(controls, data, count, groups * 4, groups ? ids[groups * 4 - 1] : 0, ids);
+    }
+
+    /* compares each block of 4 against every rotation of the other block, keeping the matches of a */
+    __attribute__((target("sse4.1,popcnt")))
+    inline std::size_t intersect_sse41(const record_id* a, std::size_t a_count, const record_id* b, std::size_t b_count, record_id* out)
+    {
+      const auto& tables = compact_table();
+      std::size_t i = 0;
+      std::size_t j = 0;
+      std::size_t written = 0;
+      while (i + 4 <= a_count && j + 4 <= b_count)
+      {
+        const __m128i a4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i b4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        const __m128i equal = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(a4, b4),
+                                                        _mm_cmpeq_epi32(a4, _mm_shuffle_epi32(b4, _MM_SHUFFLE(0, 3, 2, 1)))),
+                                           _mm_or_si128(_mm_cmpeq_epi32(a4, _mm_shuffle_epi32(b4, _MM_SHUFFLE(1, 0, 3, 2))),
+                                                        _mm_cmpeq_epi32(a4, _mm_shuffle_epi32(b4, _MM_SHUFFLE(2, 1, 0, 3)))));
+        const int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + written),
+                         _mm_shuffle_epi8(a4, _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.shuffles[mask]))));
+        written += _mm_popcnt_u32(unsigned(mask));
+
+        const record_id a_last = a[i + 3];
+        const record_id b_last = b[j + 3];
+        if (a_last <= b_last)
+          i += 4;
+        if (b_last <= a_last)
+          j += 4;
+      }
+      return written + intersect_scalar(a + i, a_count - i, b + j, b_count - j, out + written);
+    }
+
+    /* bitonic merge of two sorted blocks into the 4 least and 4 greatest, both sorted */
+    __attribute__((target("sse4.1")))
+    inline void bitonic_merge(__m128i& low, __m128i& high)
+    {
+      const __m128i reversed = _mm_shuffle_epi32(high, _MM_SHUFFLE(0, 1, 2, 3));
+      const __m128i low1 = _mm_min_epu32(low, reversed);
+      const __m128i high1 = _mm_max_epu32(low, reversed);
+
+      const __m128i near2 = _mm_unpacklo_epi64(low1, high1);
+      const __m128i far2 = _mm_unpackhi_epi64(low1, high1);
+      const __m128i low2 = _mm_min_epu32(near2, far2);
+      const __m128i high2 = _mm_max_epu32(near2, far2);
+
+      const __m128i even = _mm_unpacklo_epi32(low2, high2);
+      const __m128i odd = _mm_unpackhi_epi32(low2, high2);
+      const __m128i near3 = _mm_unpacklo_epi64(even, odd);
+      const __m128i far3 = _mm_unpackhi_epi64(even, odd);
+      const __m128i low3 = _mm_min_epu32(near3, far3);
+      const __m128i high3 = _mm_max_epu32(near3, far3);
+
+      low = _mm_unpacklo_epi32(low3, high3);
+      high = _mm_unpackhi_epi32(low3, high3);
+    }
+
+    /* writes the sorted block without ids equal to their predecessor */
+    __attribute__((target("sse4.1,popcnt")))
+    inline std::size_t write_distinct(__m128i block, __m128i& last, record_id* out, std::size_t written)
+    {
+      const __m128i previous = _mm_alignr_epi8(block, last, 12);
+      const int mask = ~_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, previous))) & 0xF;
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + written),
+                       _mm_shuffle_epi8(block, _mm_loadu_si128(reinterpret_cast<const __m128i*>(compact_table().shuffles[mask]))));
+      last = block;
+      return written + _mm_popcnt_u32(unsigned(mask));
+    }
+
+    /* merges a block at a time through a bitonic network, taking the next block from whichever list has the lesser head */
+    __attribute__((target("sse4.1,popcnt")))
+    inline std::size_t unite_sse41(const record_id* a, std::size_t a_count, const record_id* b, std::size_t b_count, record_id* out)
+    {
+      if (a_count < 4 || b_count < 4)
+        return unite_scalar(a, a_count, b, b_count, out, 0);
+
+      __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+      __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+      std::size_t i = 4;
+      std::size_t j = 4;
+      bitonic_merge(low, high);
+
+      /* a last lane unlike the first id */
+      __m128i last = _mm_set1_epi32(int(_mm_cvtsi128_si32(low) - 1));
+      std::size_t written = write_distinct(low, last, out, 0);
+      while (i + 4 <= a_count && j + 4 <= b_count)
+      {
+        if (a[i] <= b[j])
+        {
+          low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+          i += 4;
+        }
+        else
+        {
+          low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+          j += 4;
+        }
+        bitonic_merge(low, high);
+        written = write_distinct(low, last, out, written);
+      }
+
+      /* the greatest block and what is left of each list */
+      record_id greatest[4];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(greatest), high);
+      std::size_t g = 0;
+      while (g < 4 || i < a_count || j < b_count)
+      {
+        record_id next = g < 4 ? greatest[g] : i < a_count ? a[i] : b[j];
+        if (i < a_count && a[i] < next)
+          next = a[i];
+        if (j < b_count && b[j] < next)
+          next = b[j];
+        for (; g < 4 && greatest[g] == next; ++g);
+        for (; i < a_count && a[i] == next; ++i);
+        for (; j < b_count && b[j] == next; ++j);
+        if (out[written - 1] != next)
+          out[written++] = next;
+      }
+      return written;
+    }
+#endif
+  }
+
+  inline bool postings_simd()
+  {
+#ifdef DM_POSTINGS_X86
+    static const bool simd = __builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("popcnt");
+    return simd;
+#else
+    return false;
+#endif
+  }
+
+  /* appends the ids in both sorted lists */
+  inline void intersect_ids(const record_id* a, std::size_t a_count, const record_id* b, std::size_t b_count, std::vector<record_id>& out, bool simd = postings_simd())
+  {
+    const auto start = out.size();
+    out.resize(start + std::min(a_count, b_count) + 4);
+#ifdef DM_POSTINGS_X86
+    if (simd && postings_simd())
+    {
+      out.resize(start + detail::intersect_sse41(a, a_count, b, b_count, out.data() + start));
+      return;
+    }
+#endif
+    out.resize(start + detail::intersect_scalar(a, a_count, b, b_count, out.data() + start));
+  }
+
+  /* appends the distinct ids in either sorted list */
+  inline void unite_ids(const record_id* a, std::size_t a_count, const record_id* b, std::size_t b_count, std::vector<record_id>& out, bool simd = postings_simd())
+  {
+    const auto start = out.size();
+    out.resize(start + a_count + b_count + 4);
+#ifdef DM_POSTINGS_X86
+    if (simd && postings_simd())
+    {
+      out.resize(start + detail::unite_sse41(a, a_count, b, b_count, out.data() + start));
+      return;
+    }
+#endif
+    out.resize(start + detail::unite_scalar(a, a_count, b, b_count, out.data() + start, 0));
+  }
+
+  /* an index whose postings are delta encoded with Stream VByte, decoded with SSSE3 where the CPU has it;
+     dense postings of common keys take little over a byte an id */
+  class compressed_index
+  {
+  public:
+    explicit compressed_index(const index_view& index):
+      keys_(index.keys(), index.keys() + index.size()),
+      offsets_(index.offsets(), index.offsets() + index.size() + 1)
+    {
+      starts_.reserve(index.size() + 1);
+      for (std::size_t position = 0; position < index.size(); ++position)
+      {
+        starts_.push_back(bytes_.size());
+        const auto ids = index.postings(position);
+        detail::vbyte_encode(ids.begin(), ids.size(), bytes_);
+      }
+      starts_.push_back(bytes_.size());
+
+      /* the vector decoder reads 16 bytes at a time */
+      bytes_.resize(bytes_.size() + 16);
+    }
+
+    std::size_t size() const
+    {
+      return keys_.size();
+    }
+
+    const std::vector<packed_key>& keys() const
+    {
+      return keys_;
+    }
+
+    std::size_t find(packed_key key) const
+    {
+      auto found = std::lower_bound(keys_.begin(), keys_.end(), key);
+      return found != keys_.end() && *found == key ? found - keys_.begin() : keys_.size();
+    }
+
+    /* number of ids of the key at position */
+    std::size_t count(std::size_t position) const
+    {
+      return offsets_[position + 1] - offsets_[position];
+    }
+
+    /* bytes of encoded postings */
+    std::size_t encoded_size() const
+    {
+      return bytes_.size() - 16;
+    }
+
+    /* appends the ascending ids of the key at position */
+    void decode(std::size_t position, std::vector<record_id>& ids, bool simd = postings_simd()) const
+    {
+      const auto start = ids.size();
+      const auto decoded = count(position);
+      const std::uint8_t* controls = bytes_.data() + starts_[position];
+      const std::uint8_t* data = controls + (decoded + 3) / 4;
+      ids.resize(start + decoded + 4);
+#ifdef DM_POSTINGS_X86
+      if (simd && postings_simd())
+        detail::vbyte_decode_ssse3(controls, data, decoded, ids.data() + start);
+      else
+#endif
+        detail::vbyte_decode_scalar(controls, data, decoded, 0, 0, ids.data() + start);
+      ids.resize(start + decoded);
+    }
+
+    /* appends the ascending ids having either key */
+    void lookup(const packed_keys& keys, std::vector<record_id>& ids, bool simd = postings_simd()) const
+    {
+      std::vector<record_id> decoded;
+      const auto position1 = find(keys.first);
+      const auto position2 = keys.second != keys.first ? find(keys.second) : keys_.size();
+      if (position1 != keys_.size())
+        decode(position1, decoded, simd);
+      const auto middle = decoded.size();
+      if (position2 != keys_.size())
+        decode(position2, decoded, simd);
+      unite_ids(decoded.data(), middle, decoded.data() + middle, decoded.size() - middle, ids, simd);
+    }
+
+  private:
+    std::vector<packed_key> keys_;
+    std::vector<std::uint32_t> offsets_;
+    std::vector<std::size_t> starts_;
+    std::vector<std::uint8_t> bytes_;
+  };
+}
+
+#endif
@@ -0,0 +1,190 @@
+//
+//  double_metaphone_prefix.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_PREFIX_H
+#define DM_DOUBLE_METAPHONE_PREFIX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "double_metaphone_index.h"
+
+namespace dm
+{
+  /* cursors a merge holds at once by default, 16 bytes each */
+  const std::size_t merge_cursors = 1024;
+
+  /* streams the distinct ids of a run of keys in ascending order, merging their postings through a heap of cursors;
+     ids are read in place, nothing is copied up front. The heap holds at most max_cursors cursors, those of the keys
+     with the least ids to come, and the run is scanned again for the next of them once the heap's ids pass the least
+     id of the keys left out, so a run of up to max_cursors keys is scanned once and a longer one takes memory of
+     max_cursors rather than of its keys */
+  class merged_postings
+  {
+  public:
+    /* the keys at positions first up to last */
+    merged_postings(const index_view& index, std::size_t first, std::size_t last, std::size_t max_cursors = merge_cursors):
+      index_(index),
+      first_(first),
+      last_(last),
+      max_cursors_(std::max<std::size_t>(max_cursors, 1)),
+      next_(0)
+    {
+      refill();
+    }
+
+    bool valid() const
+    {
+      return !cursors_.empty();
+    }
+
+    record_id current() const
+    {
+      return *cursors_.front().first;
+    }
+
+    /* past every copy of current() */
+    void advance()
+    {
+      const record_id id = current();
+      do
+      {
+        if (++cursors_.front().first == cursors_.front().last)
+        {
+          cursors_.front() = cursors_.back();
+          cursors_.pop_back();
+        }
+        if (!cursors_.empty())
+          sift(0);
+      }
+      while (!cursors_.empty() && current() == id);
+      next_ = std::uint64_t(id) + 1;
+
+      /* scan again once the keys left out may hold copies of id, or ids below the heap's */
+      if (id >= bound_)
+        refill();
+      else if (bound_ != no_bound && (cursors_.empty() || current() > bound_))
+      {
+        next_ = bound_;
+        refill();
+      }
+    }
+
+    /* up to count ids into ids, returning how many */
+    std::size_t read(record_id* ids, std::size_t count)
+    {
+      std::size_t read = 0;
+      for (; read < count && valid(); ++read)
+      {
+        ids[read] = current();
+        advance();
+      }
+      return read;
+    }
+
+  private:
+    static const std::uint64_t no_bound = std::uint64_t(1) << 32;
+
+    /* cursors at next_ of the keys with the least ids to come, and the least id to come of the keys left out */
+    void refill()
+    {
+      auto later = [](const id_range& range1, const id_range& range2) { return *range1.first < *range2.first; };
+      cursors_.clear();
+      bound_ = no_bound;
+      for (std::size_t position = first_; position < last_; ++position)
+      {
+        const auto ids = index_.postings(position);
+        const id_range cursor = { std::lower_bound(ids.begin(), ids.end(), next_), ids.end() };
+        if (cursor.first == cursor.last)
+          continue;
+        if (cursors_.size() < max_cursors_)
+        {
+          cursors_.push_back(cursor);
+          std::push_heap(cursors_.begin(), cursors_.end(), later);
+        }
+        else if (*cursor.first < *cursors_.front().first)
+        {
+          bound_ = std::min<std::uint64_t>(bound_, *cursors_.front().first);
+          std::pop_heap(cursors_.begin(), cursors_.end(), later);
+          cursors_.back() = cursor;
+          std::push_heap(cursors_.begin(), cursors_.end(), later);
+        }
+        else
+          bound_ = std::min<std::uint64_t>(bound_, *cursor.first);
+      }
+      for (std::size_t parent = cursors_.size() / 2; parent-- > 0;)
+        sift(parent);
+    }
+
+    /* moves the cursor at parent down below any cursor with a lesser id */
+    void sift(std::size_t parent)
+    {
+      const id_range moved = cursors_[parent];
+      const std::size_t size = cursors_.size();
+      for (std::size_t child = parent * 2 + 1; child < size; child = parent * 2 + 1)
+      {
+        if (child + 1 < size && *cursors_[child + 1].first < *cursors_[child].first)
+          ++child;
+        if (!(*cursors_[child].first < *moved.first))
+          break;
+        cursors_[parent] = cursors_[child];
+        parent = child;
+      }
+      cursors_[parent] = moved;
+    }
+
+    index_view index_;
+    std::size_t first_;
+    std::size_t last_;
+    std::size_t max_cursors_;
+
+    /* ids below next_ are done, and ids below bound_ are all in the heap */
+    std::uint64_t next_;
+    std::uint64_t bound_;
+    std::vector<id_range> cursors_;
+  };
+
+  /* ids of the records with a key starting with the first len symbols of prefix */
+  inline merged_postings prefix_postings(const index_view& index, packed_key prefix, std::size_t len,
+                                         std::size_t max_cursors = merge_cursors)
+  {
+    const auto range = index.prefix_range(prefix, len);
+    return merged_postings(index, range.first, range.second, max_cursors);
+  }
+
+  /* ids of the records with a key starting with a key string, e.g. "PRN" for Barnes, Barnard and Barnsley */
+  inline merged_postings prefix_postings(const index_view& index, const std::string& prefix, std::size_t max_cursors = merge_cursors)
+  {
+    return prefix_postings(index, pack_key(prefix), prefix.length(), max_cursors);
+  }
+}
+
+#endif
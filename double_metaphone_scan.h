@@ -0,0 +1,253 @@
+//
+//  double_metaphone_scan.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_SCAN_H
+#define DM_DOUBLE_METAPHONE_SCAN_H
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+#include "double_metaphone_packed.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DM_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace dm
+{
+  /* instruction sets for scanning a column of packed keys */
+  enum class scan_isa
+  {
+    scalar,
+    avx2,
+    avx512
+  };
+
+  namespace detail
+  {
+    struct scan_query
+    {
+      packed_key key1;
+      packed_key mask1;
+      packed_key key2;
+      packed_key mask2;
+    };
+
+    inline std::size_t popcount(std::uint64_t bits)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_popcountll(bits);
+#else
+      return std::bitset<64>(bits).count();
+#endif
+    }
+
+    inline std::uint64_t scan_block_scalar(const packed_key* column, std::size_t count, const scan_query& query)
+    {
+      std::uint64_t bits = 0;
+      for (std::size_t i = 0; i < count; ++i)
+        bits |= std::uint64_t(((column[i] & query.mask1) == query.key1)
+                              | ((column[i] & query.mask2) == query.key2)) << i;
+      return bits;
+    }
+
+    /* scans from block onwards with the scalar kernel, for the tail of the vector kernels */
+    inline std::size_t scan_scalar(const packed_key* column, std::size_t count, std::size_t block, const scan_query& query, std::uint64_t* bitmap)
+    {
+      std::size_t matches = 0;
+      for (; block * 64 < count; ++block)
+      {
+        auto bits = scan_block_scalar(column + block * 64, std::min<std::size_t>(64, count - block * 64), query);
+        bitmap[block] = bits;
+        matches += popcount(bits);
+      }
+      return matches;
+    }
+
+#ifdef DM_SCAN_X86
+    __attribute__((target("avx2,popcnt")))
+    inline std::size_t scan_avx2(const packed_key* column, std::size_t count, const scan_query& query, std::uint64_t* bitmap)
+    {
+      const __m256i key1 = _mm256_set1_epi64x(query.key1);
+      const __m256i mask1 = _mm256_set1_epi64x(query.mask1);
+      const __m256i key2 = _mm256_set1_epi64x(query.key2);
+      const __m256i mask2 = _mm256_set1_epi64x(query.mask2);
+
+      std::size_t matches = 0;
+      const std::size_t blocks = count / 64;
+      for (std::size_t block = 0; block < blocks; ++block)
+      {
+        const packed_key* keys = column + block * 64;
+        std::uint64_t bits = 0;
+        for (unsigned i = 0; i < 64; i += 4)
+        {
+          const __m256i keys4 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+          const __m256i equal = _mm256_or_si256(_mm256_cmpeq_epi64(_mm256_and_si256(keys4, mask1), key1),
+                                                _mm256_cmpeq_epi64(_mm256_and_si256(keys4, mask2), key2));
+          bits |= std::uint64_t(_mm256_movemask_pd(_mm256_castsi256_pd(equal))) << i;
+        }
+        bitmap[block] = bits;
+        matches += _mm_popcnt_u64(bits);
+      }
+      return matches + scan_scalar(column, count, blocks, query, bitmap);
+    }
+
+    __attribute__((target("avx512f,popcnt")))
+    inline std::size_t scan_avx512(const packed_key* column, std::size_t count, const scan_query& query, std::uint64_t* bitmap)
+    {
+      const __m512i key1 = _mm512_set1_epi64(query.key1);
+      const __m512i mask1 = _mm512_set1_epi64(query.mask1);
+      const __m512i key2 = _mm512_set1_epi64(query.key2);
+      const __m512i mask2 = _mm512_set1_epi64(query.mask2);
+
+      std::size_t matches = 0;
+      const std::size_t blocks = count / 64;
+      for (std::size_t block = 0; block < blocks; ++block)
+      {
+        const packed_key* keys = column + block * 64;
+        std::uint64_t bits = 0;
+        for (unsigned i = 0; i < 64; i += 8)
+        {
+          const __m512i keys8 = _mm512_loadu_si512(keys + i);
+          const __mmask8 equal = _mm512_cmpeq_epi64_mask(_mm512_and_si512(keys8, mask1), key1)
+            | _mm512_cmpeq_epi64_mask(_mm512_and_si512(keys8, mask2), key2);
+          bits |= std::uint64_t(equal) << i;
+        }
+        bitmap[block] = bits;
+        matches += _mm_popcnt_u64(bits);
+      }
+      return matches + scan_scalar(column, count, blocks, query, bitmap);
+    }
+#endif
+  }
+
+  inline scan_isa best_scan_isa()
+  {
+#ifdef DM_SCAN_X86
+    static const scan_isa best =
+      __builtin_cpu_supports("avx512f") ? scan_isa::avx512 :
+      __builtin_cpu_supports("avx2") ? scan_isa::avx2 :
+      scan_isa::scalar;
+    return best;
+#else
+    return scan_isa::scalar;
+#endif
+  }
+
+  /* sets bit i of bitmap when column[i] masked by mask1 is query.first or masked by mask2 is query.second;
+     bitmap takes (count + 63) / 64 words, returns the number of matches */
+  inline std::size_t scan_keys(const packed_key* column,
+                               std::size_t count,
+                               const packed_keys& query,
+                               packed_key mask1,
+                               packed_key mask2,
+                               std::uint64_t* bitmap,
+                               scan_isa isa = best_scan_isa())
+  {
+    const detail::scan_query masked = { query.first & mask1, mask1, query.second & mask2, mask2 };
+
+    /* never run a kernel the machine can't */
+    switch (std::min(isa, best_scan_isa()))
+    {
+#ifdef DM_SCAN_X86
+      case scan_isa::avx512:
+        return detail::scan_avx512(column, count, masked, bitmap);
+      case scan_isa::avx2:
+        return detail::scan_avx2(column, count, masked, bitmap);
+#endif
+      default:
+        return detail::scan_scalar(column, count, 0, masked, bitmap);
+    }
+  }
+
+  /* keys equal to either query key */
+  inline std::size_t scan_exact(const packed_key* column, std::size_t count, const packed_keys& query, std::uint64_t* bitmap, scan_isa isa = best_scan_isa())
+  {
+    return scan_keys(column, count, query, ~packed_key(0), ~packed_key(0), bitmap, isa);
+  }
+
+  /* keys starting with either query key, an empty query key starts every key */
+  inline std::size_t scan_prefix(const packed_key* column, std::size_t count, const packed_keys& query, std::uint64_t* bitmap, scan_isa isa = best_scan_isa())
+  {
+    return scan_keys(column, count, query,
+                     packed_prefix_mask(packed_length(query.first)),
+                     packed_prefix_mask(packed_length(query.second)),
+                     bitmap, isa);
+  }
+
+  /* appends the positions of set bits in bitmap */
+  inline void bitmap_positions(const std::uint64_t* bitmap, std::size_t count, std::size_t base, std::vector<std::size_t>& positions)
+  {
+    for (std::size_t block = 0; block * 64 < count; ++block)
+      for (auto bits = bitmap[block]; bits; bits &= bits - 1)
+        positions.push_back(base + block * 64 + detail::popcount(~bits & (bits - 1)));
+  }
+
+  /* appends the positions of matching keys, scanning a chunk at a time to keep the bitmap in cache */
+  inline std::size_t scan_keys(const packed_key* column,
+                               std::size_t count,
+                               const packed_keys& query,
+                               packed_key mask1,
+                               packed_key mask2,
+                               std::vector<std::size_t>& positions,
+                               scan_isa isa = best_scan_isa())
+  {
+    const std::size_t chunk = 4096;
+    std::uint64_t bitmap[chunk / 64];
+    std::size_t matches = 0;
+    for (std::size_t start = 0; start < count; start += chunk)
+    {
+      const auto size = std::min(chunk, count - start);
+      if (scan_keys(column + start, size, query, mask1, mask2, bitmap, isa))
+      {
+        const auto before = positions.size();
+        bitmap_positions(bitmap, size, start, positions);
+        matches += positions.size() - before;
+      }
+    }
+    return matches;
+  }
+
+  inline std::size_t scan_exact(const packed_key* column, std::size_t count, const packed_keys& query, std::vector<std::size_t>& positions, scan_isa isa = best_scan_isa())
+  {
+    return scan_keys(column, count, query, ~packed_key(0), ~packed_key(0), positions, isa);
+  }
+
+  inline std::size_t scan_prefix(const packed_key* column, std::size_t count, const packed_keys& query, std::vector<std::size_t>& positions, scan_isa isa = best_scan_isa())
+  {
+    return scan_keys(column, count, query,
+                     packed_prefix_mask(packed_length(query.first)),
+                     packed_prefix_mask(packed_length(query.second)),
+                     positions, isa);
+  }
+}
+
+#endif
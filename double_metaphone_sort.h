@@ -0,0 +1,288 @@
+//
+//  double_metaphone_sort.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_SORT_H
+#define DM_DOUBLE_METAPHONE_SORT_H
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+#include "double_metaphone_index.h"
+#include "double_metaphone_parallel.h"
+
+namespace dm
+{
+  namespace detail
+  {
+    /* least significant digits first: 4 bytes of id then 8 bytes of key */
+    const unsigned radix_digits = 12;
+
+    inline unsigned radix_digit(const index::entry& entry, unsigned digit)
+    {
+      return digit < 4 ? (entry.second >> (digit * 8)) & 0xFF : (entry.first >> ((digit - 4) * 8)) & 0xFF;
+    }
+  }
+
+  /* LSD radix sort of entries by key then id, histogramming and scattering across threads;
+     digits where all entries agree are skipped, which is most of a short key */
+  inline void radix_sort(std::vector<index::entry>& entries, unsigned threads = default_threads())
+  {
+    const std::size_t count = entries.size();
+    threads = std::max(1u, std::min<unsigned>(threads, unsigned(count / 65536) + 1));
+
+    /* one pass over the entries finds the digits worth sorting */
+    std::vector<std::size_t> totals(threads * detail::radix_digits * 256);
+    parallel_for(count, threads, [&](unsigned thread, std::size_t first, std::size_t last)
+                 {
+                   auto histograms = &totals[thread * detail::radix_digits * 256];
+                   for (auto i = first; i < last; ++i)
+                     for (unsigned digit = 0; digit < detail::radix_digits; ++digit)
+                       ++histograms[digit * 256 + detail::radix_digit(entries[i], digit)];
+                 });
+    for (unsigned thread = 1; thread < threads; ++thread)
+      for (std::size_t bucket = 0; bucket < detail::radix_digits * 256; ++bucket)
+        totals[bucket] += totals[thread * detail::radix_digits * 256 + bucket];
+
+    std::vector<index::entry> scratch(count);
+    std::vector<std::size_t> cursors(threads * 256);
+    for (unsigned digit = 0; digit < detail::radix_digits; ++digit)
+    {
+      if (std::find(totals.begin() + digit * 256, totals.begin() + (digit + 1) * 256, count) != totals.begin() + (digit + 1) * 256)
+        continue;
+
+      std::fill(cursors.begin(), cursors.end(), 0);
+      parallel_for(count, threads, [&](unsigned thread, std::size_t first, std::size_t last)
+                   {
+                     auto histogram = &cursors[thread * 256];
+                     for (auto i = first; i < last; ++i)
+                       ++histogram[detail::radix_digit(entries[i], digit)];
+                   });
+
+      /* bucket by bucket, each thread's run follows the previous thread's so the sort stays stable */
+      std::size_t total = 0;
+      for (unsigned bucket = 0; bucket < 256; ++bucket)
+        for (unsigned thread = 0; thread < threads; ++thread)
+        {
+          const auto size = cursors[thread * 256 + bucket];
+          cursors[thread * 256 + bucket] = total;
+          total += size;
+        }
+
+      parallel_for(count, threads, [&](unsigned thread, std::size_t first, std::size_t last)
+                   {
+                     auto cursor = &cursors[thread * 256];
+                     for (auto i = first; i < last; ++i)
+                       scratch[cursor[detail::radix_digit(entries[i], digit)]++] = entries[i];
+                   });
+      entries.swap(scratch);
+    }
+  }
+
+  /* index of entries grouped by key, ids ascending */
+  inline index group_by(std::vector<index::entry> entries, unsigned threads = default_threads())
+  {
+    radix_sort(entries, threads);
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+    return index::grouped(entries);
+  }
+
+  /* clusters of record i under keys[i], e.g. each record's primary key */
+  inline index group_by(const packed_key* keys, std::size_t count, unsigned threads = default_threads())
+  {
+    std::vector<index::entry> entries(count);
+    for (std::size_t i = 0; i < count; ++i)
+      entries[i] = index::entry(keys[i], record_id(i));
+    return group_by(std::move(entries), threads);
+  }
+
+  /* groups more entries than fit in memory: entries beyond the memory budget are radix sorted into runs
+     spilled to temporary files, which are then merged a key at a time */
+  class external_sorter
+  {
+  public:
+    explicit external_sorter(std::size_t memory_entries, unsigned threads = default_threads()):
+      memory_entries_(std::max<std::size_t>(memory_entries, 1024)),
+      threads_(threads)
+    {
+      entries_.reserve(memory_entries_);
+    }
+
+    void add(packed_key key, record_id id)
+    {
+      entries_.push_back(index::entry(key, id));
+      if (entries_.size() == memory_entries_)
+        spill();
+    }
+
+    /* calls callback(key, ids, count) per key in ascending key order with distinct ascending ids,
+       the ids only valid during the call; consumes the added entries */
+    template <typename F> void group(F callback)
+    {
+      radix_sort(entries_, threads_);
+
+      /* the entries in memory are just another run */
+      std::vector<run> runs;
+      runs.reserve(runs_.size() + 1);
+      const std::size_t buffer = std::max<std::size_t>(memory_entries_ / (runs_.size() + 1), 4096);
+      for (auto& file : runs_)
+      {
+        std::rewind(file.get());
+        runs.push_back(run(file.get(), buffer));
+      }
+      runs.push_back(run(entries_));
+
+      auto later = [&runs](std::size_t run1, std::size_t run2)
+      {
+        return runs[run2].current() < runs[run1].current();
+      };
+      std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(later)> heads(later);
+      for (std::size_t which = 0; which < runs.size(); ++which)
+        if (runs[which].valid())
+          heads.push(which);
+
+      std::vector<record_id> ids;
+      packed_key key = 0;
+      while (!heads.empty())
+      {
+        const auto which = heads.top();
+        heads.pop();
+        const auto entry = runs[which].current();
+        if (!ids.empty() && entry.first != key)
+        {
+          callback(key, ids.data(), ids.size());
+          ids.clear();
+        }
+        if (ids.empty() || ids.back() != entry.second)
+          ids.push_back(entry.second);
+        key = entry.first;
+        runs[which].advance();
+        if (runs[which].valid())
+          heads.push(which);
+      }
+      if (!ids.empty())
+        callback(key, ids.data(), ids.size());
+
+      entries_.clear();
+      runs_.clear();
+    }
+
+    /* groups into an index, when the result fits in memory */
+    index build()
+    {
+      std::vector<packed_key> keys;
+      std::vector<std::uint32_t> offsets;
+      std::vector<record_id> ids;
+      group([&](packed_key key, const record_id* key_ids, std::size_t count)
+            {
+              keys.push_back(key);
+              offsets.push_back(std::uint32_t(ids.size()));
+              ids.insert(ids.end(), key_ids, key_ids + count);
+            });
+      offsets.push_back(std::uint32_t(ids.size()));
+      return index(std::move(keys), std::move(offsets), std::move(ids));
+    }
+
+    std::size_t runs() const
+    {
+      return runs_.size();
+    }
+
+  private:
+    struct file_closer
+    {
+      void operator()(std::FILE* file) const
+      {
+        std::fclose(file);
+      }
+    };
+
+    /* cursor over a sorted run, in memory or buffered from a file */
+    class run
+    {
+    public:
+      run(std::FILE* file, std::size_t buffer): file_(file), buffer_(buffer), data_(nullptr), position_(0), size_(0)
+      {
+      }
+
+      explicit run(const std::vector<index::entry>& entries): file_(nullptr), data_(entries.data()), position_(0), size_(entries.size())
+      {
+      }
+
+      /* whether there is a current entry, reading more of the file when needed */
+      bool valid()
+      {
+        if (position_ == size_ && file_)
+        {
+          size_ = std::fread(buffer_.data(), sizeof(index::entry), buffer_.size(), file_);
+          data_ = buffer_.data();
+          position_ = 0;
+        }
+        return position_ < size_;
+      }
+
+      const index::entry& current() const
+      {
+        return data_[position_];
+      }
+
+      void advance()
+      {
+        ++position_;
+      }
+
+    private:
+      std::FILE* file_;
+      std::vector<index::entry> buffer_;
+      const index::entry* data_;
+      std::size_t position_;
+      std::size_t size_;
+    };
+
+    void spill()
+    {
+      radix_sort(entries_, threads_);
+      std::unique_ptr<std::FILE, file_closer> file(std::tmpfile());
+      if (!file || std::fwrite(entries_.data(), sizeof(index::entry), entries_.size(), file.get()) != entries_.size())
+        throw std::runtime_error("double_metaphone: can't spill sorted run");
+      runs_.push_back(std::move(file));
+      entries_.clear();
+    }
+
+    std::size_t memory_entries_;
+    unsigned threads_;
+    std::vector<index::entry> entries_;
+    std::vector<std::unique_ptr<std::FILE, file_closer>> runs_;
+  };
+}
+
+#endif
@@ -0,0 +1,194 @@
+//
+//  double_metaphone_spans.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_DOUBLE_METAPHONE_SPANS_H
+#define DM_DOUBLE_METAPHONE_SPANS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "double_metaphone.h"
+
+namespace dm
+{
+  /* input bytes start up to start + len */
+  struct source_span
+  {
+    std::uint32_t start;
+    std::uint32_t len;
+  };
+
+  inline bool operator==(const source_span& span1, const source_span& span2)
+  {
+    return span1.start == span2.start && span1.len == span2.len;
+  }
+
+  inline bool operator!=(const source_span& span1, const source_span& span2)
+  {
+    return !(span1 == span2);
+  }
+
+  /* the symbols of one key and the input spans producing them */
+  struct spanned_key
+  {
+    const char* symbols;
+    const source_span* spans;
+    std::size_t size;
+  };
+
+  /* the keys of many words flat, each symbol with the input span producing it */
+  class key_spans
+  {
+  public:
+    /* symbols of all the words, their spans, and where each word's symbols end */
+    struct flat
+    {
+      std::string symbols;
+      std::vector<source_span> spans;
+      std::vector<std::uint32_t> ends;
+
+      spanned_key operator[](std::size_t word) const
+      {
+        const std::size_t first = word ? ends[word - 1] : 0;
+        return spanned_key { symbols.data() + first, spans.data() + first, ends[word] - first };
+      }
+    };
+
+    void add(const std::string& word, const encode_limits& limits = encode_limits())
+    {
+      double_metaphone(word,
+                       [this](const char* metaph1, const char* metaph2, size_t start, size_t len)
+                       {
+                         append(primaries_, metaph1, start, len);
+                         append(alternates_, metaph2, start, len);
+                       },
+                       limits);
+      primaries_.ends.push_back(std::uint32_t(primaries_.symbols.size()));
+      alternates_.ends.push_back(std::uint32_t(alternates_.symbols.size()));
+    }
+
+    /* number of words */
+    std::size_t size() const
+    {
+      return primaries_.ends.size();
+    }
+
+    spanned_key primary(std::size_t word) const
+    {
+      return primaries_[word];
+    }
+
+    spanned_key alternate(std::size_t word) const
+    {
+      return alternates_[word];
+    }
+
+    const flat& primaries() const
+    {
+      return primaries_;
+    }
+
+    const flat& alternates() const
+    {
+      return alternates_;
+    }
+
+    void clear()
+    {
+      for (auto flat : {&primaries_, &alternates_})
+      {
+        flat->symbols.clear();
+        flat->spans.clear();
+        flat->ends.clear();
+      }
+    }
+
+  private:
+    static void append(flat& keys, const char* metaph, size_t start, size_t len)
+    {
+      if (metaph)
+        for (; *metaph; ++metaph)
+        {
+          keys.symbols += *metaph;
+          keys.spans.push_back(source_span { std::uint32_t(start), std::uint32_t(len) });
+        }
+    }
+
+    flat primaries_;
+    flat alternates_;
+  };
+
+  /* appends the keys of many words with their spans, reusing the storage of spans */
+  inline void double_metaphone_spans(const std::string* words, std::size_t count, key_spans& spans, const encode_limits& limits = encode_limits())
+  {
+    for (std::size_t word = 0; word < count; ++word)
+      spans.add(words[word], limits);
+  }
+
+  namespace detail
+  {
+    /* appends span, joining it to the last if they touch or overlap */
+    inline void add_span(std::vector<source_span>& spans, const source_span& span)
+    {
+      if (!spans.empty() && span.start <= spans.back().start + spans.back().len)
+        spans.back().len = std::max(spans.back().len, span.start + span.len - spans.back().start);
+      else
+        spans.push_back(span);
+    }
+  }
+
+  /* appends the input spans of the symbols two keys have in common, aligned as a longest common subsequence,
+     to spans1 for the first key's input and spans2 for the second's; touching spans are joined */
+  inline void matching_spans(const spanned_key& key1, const spanned_key& key2,
+                             std::vector<source_span>& spans1, std::vector<source_span>& spans2)
+  {
+    /* common[i * width + j] is the longest common subsequence of the symbols of key1 from i and of key2 from j */
+    const std::size_t width = key2.size + 1;
+    std::vector<std::uint32_t> common((key1.size + 1) * width, 0);
+    for (std::size_t i = key1.size; i-- > 0;)
+      for (std::size_t j = key2.size; j-- > 0;)
+        common[i * width + j] = key1.symbols[i] == key2.symbols[j]
+          ? common[(i + 1) * width + j + 1] + 1
+          : std::max(common[(i + 1) * width + j], common[i * width + j + 1]);
+
+    for (std::size_t i = 0, j = 0; i < key1.size && j < key2.size;)
+      if (key1.symbols[i] == key2.symbols[j])
+      {
+        detail::add_span(spans1, key1.spans[i++]);
+        detail::add_span(spans2, key2.spans[j++]);
+      }
+      else if (common[(i + 1) * width + j] >= common[i * width + j + 1])
+        ++i;
+      else
+        ++j;
+  }
+}
+
+#endif
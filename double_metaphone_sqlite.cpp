@@ -0,0 +1,489 @@
+//
+//  double_metaphone_sqlite.cpp
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+//  SQLite loadable extension:
+//
+//    dmetaphone(x), dmetaphone_alt(x)          primary and alternate keys as text
+//    dmetaphone_key(x), dmetaphone_alt_key(x)  packed keys as integers, for expression indexes
+//    sounds_like(x, y)                         whether x and y share a key
+//
+//  and the dmetaphone virtual table, whose names are indexed by packed key in a shadow table
+//  so that WHERE sounds_like(name, ?) is an index lookup:
+//
+//    CREATE VIRTUAL TABLE people USING dmetaphone;
+//    INSERT INTO people(rowid, name) VALUES (1, 'Smith');
+//    SELECT rowid, name FROM people WHERE sounds_like(name, 'Schmidt');
+
+#include <sqlite3ext.h>
+SQLITE_EXTENSION_INIT1
+
+#include <cstring>
+#include <string>
+
+#include "double_metaphone_packed.h"
+
+namespace
+{
+  std::string text_arg(sqlite3_value* value)
+  {
+    const char* text = reinterpret_cast<const char*>(sqlite3_value_text(value));
+    return text ? std::string(text, sqlite3_value_bytes(value)) : std::string();
+  }
+
+  /* packed keys round trip through SQLite integers bit for bit */
+  sqlite3_int64 key_integer(dm::packed_key key)
+  {
+    sqlite3_int64 integer;
+    std::memcpy(&integer, &key, sizeof(key));
+    return integer;
+  }
+
+  void dmetaphone_function(sqlite3_context* context, int argc, sqlite3_value** argv)
+  {
+    if (sqlite3_value_type(argv[0]) == SQLITE_NULL)
+      return;
+    const auto keys = dm::double_metaphone(text_arg(argv[0]));
+    const auto& key = sqlite3_user_data(context) ? keys.second : keys.first;
+    sqlite3_result_text(context, key.data(), int(key.length()), SQLITE_TRANSIENT);
+  }
+
+  void dmetaphone_key_function(sqlite3_context* context, int argc, sqlite3_value** argv)
+  {
+    if (sqlite3_value_type(argv[0]) == SQLITE_NULL)
+      return;
+    const auto keys = dm::double_metaphone_packed(text_arg(argv[0]));
+    sqlite3_result_int64(context, key_integer(sqlite3_user_data(context) ? keys.second : keys.first));
+  }
+
+  void sounds_like_function(sqlite3_context* context, int argc, sqlite3_value** argv)
+  {
+    if (sqlite3_value_type(argv[0]) == SQLITE_NULL || sqlite3_value_type(argv[1]) == SQLITE_NULL)
+      return;
+    const auto keys1 = dm::double_metaphone_packed(text_arg(argv[0]));
+    const auto keys2 = dm::double_metaphone_packed(text_arg(argv[1]));
+    sqlite3_result_int(context,
+                       keys1.first == keys2.first || keys1.first == keys2.second
+                       || keys1.second == keys2.first || keys1.second == keys2.second);
+  }
+
+  /* virtual table of names with shadow tables %_data(id, name) and %_keys(key, id) */
+
+  enum
+  {
+    column_name,
+    column_primary,
+    column_alternate
+  };
+
+  enum
+  {
+    plan_scan,
+    plan_sounds_like,
+    plan_rowid
+  };
+
+  struct phonetic_table
+  {
+    sqlite3_vtab base;
+    sqlite3* db;
+    std::string schema;
+    std::string name;
+
+    /* the quoted name of a shadow table; %w doubles any quotes in the names, and running out of memory leaves the
+       statement empty so preparing it fails */
+    std::string shadow(const char* suffix) const
+    {
+      char* quoted = sqlite3_mprintf("\"%w\".\"%w_%w\"", schema.c_str(), name.c_str(), suffix);
+      if (!quoted)
+        return std::string();
+      std::string copied(quoted);
+      sqlite3_free(quoted);
+      return copied;
+    }
+
+    int exec(const std::string& sql)
+    {
+      char* error = nullptr;
+      const int result = sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &error);
+      if (error)
+      {
+        sqlite3_free(base.zErrMsg);
+        base.zErrMsg = sqlite3_mprintf("%s", error);
+        sqlite3_free(error);
+      }
+      return result;
+    }
+
+    int prepare(const std::string& sql, sqlite3_stmt** statement)
+    {
+      return sqlite3_prepare_v2(db, sql.c_str(), -1, statement, nullptr);
+    }
+
+    /* adds or removes the key entries of a name */
+    int index_name(sqlite3_int64 id, const std::string& text, bool add)
+    {
+      const auto keys = dm::double_metaphone_packed(text);
+      sqlite3_stmt* statement = nullptr;
+      int result = prepare(add
+                           ? "INSERT OR IGNORE INTO " + shadow("keys") + "(key, id) VALUES (?1, ?3), (?2, ?3)"
+                           : "DELETE FROM " + shadow("keys") + " WHERE key IN (?1, ?2) AND id = ?3",
+                           &statement);
+      if (result == SQLITE_OK)
+      {
+        sqlite3_bind_int64(statement, 1, key_integer(keys.first));
+        sqlite3_bind_int64(statement, 2, key_integer(keys.second));
+        sqlite3_bind_int64(statement, 3, id);
+        result = sqlite3_step(statement) == SQLITE_DONE ? SQLITE_OK : sqlite3_errcode(db);
+      }
+      sqlite3_finalize(statement);
+      return result;
+    }
+
+    int remove(sqlite3_int64 id)
+    {
+      sqlite3_stmt* statement = nullptr;
+      int result = prepare("SELECT name FROM " + shadow("data") + " WHERE id = ?1", &statement);
+      if (result == SQLITE_OK)
+      {
+        sqlite3_bind_int64(statement, 1, id);
+        if (sqlite3_step(statement) == SQLITE_ROW)
+          result = index_name(id, text_arg(sqlite3_column_value(statement, 0)), false);
+      }
+      sqlite3_finalize(statement);
+      if (result != SQLITE_OK)
+        return result;
+
+      result = prepare("DELETE FROM " + shadow("data") + " WHERE id = ?1", &statement);
+      if (result == SQLITE_OK)
+      {
+        sqlite3_bind_int64(statement, 1, id);
+        result = sqlite3_step(statement) == SQLITE_DONE ? SQLITE_OK : sqlite3_errcode(db);
+      }
+      sqlite3_finalize(statement);
+      return result;
+    }
+
+    int insert(sqlite3_value* rowid, sqlite3_value* name, sqlite3_int64* id)
+    {
+      sqlite3_stmt* statement = nullptr;
+      int result = prepare("INSERT INTO " + shadow("data") + "(id, name) VALUES (?1, ?2)", &statement);
+      if (result == SQLITE_OK)
+      {
+        sqlite3_bind_value(statement, 1, rowid);
+        sqlite3_bind_value(statement, 2, name);
+        result = sqlite3_step(statement) == SQLITE_DONE ? SQLITE_OK : sqlite3_errcode(db);
+      }
+      sqlite3_finalize(statement);
+      if (result != SQLITE_OK)
+        return result;
+
+      *id = sqlite3_last_insert_rowid(db);
+      return sqlite3_value_type(name) == SQLITE_NULL ? SQLITE_OK : index_name(*id, text_arg(name), true);
+    }
+  };
+
+  struct phonetic_cursor
+  {
+    sqlite3_vtab_cursor base;
+    sqlite3_stmt* statement;
+    bool eof;
+  };
+
+  int phonetic_connect(sqlite3* db, void* aux, int argc, const char* const* argv, sqlite3_vtab** vtab, char** error, bool create)
+  {
+    int result = sqlite3_declare_vtab(db, "CREATE TABLE x(name TEXT, primary_key TEXT, alternate_key TEXT)");
+    if (result != SQLITE_OK)
+      return result;
+
+    auto table = new phonetic_table();
+    table->db = db;
+    table->schema = argv[1];
+    table->name = argv[2];
+    if (create)
+    {
+      result = table->exec("CREATE TABLE " + table->shadow("data") + "(id INTEGER PRIMARY KEY, name TEXT);"
+                           "CREATE TABLE " + table->shadow("keys") + "(key INTEGER NOT NULL, id INTEGER NOT NULL, PRIMARY KEY (key, id)) WITHOUT ROWID;");
+      if (result != SQLITE_OK)
+      {
+        *error = sqlite3_mprintf("%s", table->base.zErrMsg);
+        sqlite3_free(table->base.zErrMsg);
+        delete table;
+        return result;
+      }
+    }
+    sqlite3_vtab_config(db, SQLITE_VTAB_INNOCUOUS);
+    *vtab = &table->base;
+    return SQLITE_OK;
+  }
+
+  int phonetic_create(sqlite3* db, void* aux, int argc, const char* const* argv, sqlite3_vtab** vtab, char** error)
+  {
+    return phonetic_connect(db, aux, argc, argv, vtab, error, true);
+  }
+
+  int phonetic_reconnect(sqlite3* db, void* aux, int argc, const char* const* argv, sqlite3_vtab** vtab, char** error)
+  {
+    return phonetic_connect(db, aux, argc, argv, vtab, error, false);
+  }
+
+  int phonetic_disconnect(sqlite3_vtab* vtab)
+  {
+    delete reinterpret_cast<phonetic_table*>(vtab);
+    return SQLITE_OK;
+  }
+
+  int phonetic_destroy(sqlite3_vtab* vtab)
+  {
+    auto table = reinterpret_cast<phonetic_table*>(vtab);
+    const int result = table->exec("DROP TABLE " + table->shadow("data") + "; DROP TABLE " + table->shadow("keys") + ";");
+    if (result == SQLITE_OK)
+      delete table;
+    return result;
+  }
+
+  int phonetic_best_index(sqlite3_vtab* vtab, sqlite3_index_info* info)
+  {
+    int sounds_like = -1;
+    int rowid = -1;
+    for (int i = 0; i < info->nConstraint; ++i)
+    {
+      const auto& constraint = info->aConstraint[i];
+      if (!constraint.usable)
+        continue;
+      if (constraint.op == SQLITE_INDEX_CONSTRAINT_FUNCTION && constraint.iColumn == column_name)
+        sounds_like = i;
+      else if (constraint.op == SQLITE_INDEX_CONSTRAINT_EQ && constraint.iColumn == -1)
+        rowid = i;
+    }
+
+    if (rowid >= 0)
+    {
+      info->idxNum = plan_rowid;
+      info->aConstraintUsage[rowid].argvIndex = 1;
+      info->aConstraintUsage[rowid].omit = 1;
+      info->estimatedCost = 1;
+      info->estimatedRows = 1;
+      info->idxFlags = SQLITE_INDEX_SCAN_UNIQUE;
+    }
+    else if (sounds_like >= 0)
+    {
+      info->idxNum = plan_sounds_like;
+      info->idxStr = const_cast<char*>("sounds_like");
+      info->aConstraintUsage[sounds_like].argvIndex = 1;
+      info->aConstraintUsage[sounds_like].omit = 1;
+      info->estimatedCost = 10;
+      info->estimatedRows = 10;
+    }
+    else
+    {
+      info->idxNum = plan_scan;
+      info->estimatedCost = 1000000;
+    }
+    return SQLITE_OK;
+  }
+
+  int phonetic_open(sqlite3_vtab* vtab, sqlite3_vtab_cursor** cursor)
+  {
+    auto opened = new phonetic_cursor();
+    opened->statement = nullptr;
+    opened->eof = true;
+    *cursor = &opened->base;
+    return SQLITE_OK;
+  }
+
+  int phonetic_close(sqlite3_vtab_cursor* cursor)
+  {
+    auto closing = reinterpret_cast<phonetic_cursor*>(cursor);
+    sqlite3_finalize(closing->statement);
+    delete closing;
+    return SQLITE_OK;
+  }
+
+  int phonetic_next(sqlite3_vtab_cursor* cursor)
+  {
+    auto current = reinterpret_cast<phonetic_cursor*>(cursor);
+    const int result = sqlite3_step(current->statement);
+    current->eof = result != SQLITE_ROW;
+    return result == SQLITE_ROW || result == SQLITE_DONE ? SQLITE_OK : result;
+  }
+
+  int phonetic_filter(sqlite3_vtab_cursor* cursor, int plan, const char* plan_string, int argc, sqlite3_value** argv)
+  {
+    auto current = reinterpret_cast<phonetic_cursor*>(cursor);
+    auto table = reinterpret_cast<phonetic_table*>(cursor->pVtab);
+    sqlite3_finalize(current->statement);
+    current->statement = nullptr;
+
+    std::string sql = "SELECT id, name FROM " + table->shadow("data");
+    switch (plan)
+    {
+      case plan_sounds_like:
+        sql += " WHERE id IN (SELECT id FROM " + table->shadow("keys") + " WHERE key IN (?1, ?2))";
+        break;
+      case plan_rowid:
+        sql += " WHERE id = ?1";
+        break;
+    }
+
+    int result = table->prepare(sql, &current->statement);
+    if (result != SQLITE_OK)
+      return result;
+    switch (plan)
+    {
+      case plan_sounds_like:
+        if (sqlite3_value_type(argv[0]) == SQLITE_NULL)
+        {
+          current->eof = true;
+          return SQLITE_OK;
+        }
+        else
+        {
+          const auto keys = dm::double_metaphone_packed(text_arg(argv[0]));
+          sqlite3_bind_int64(current->statement, 1, key_integer(keys.first));
+          sqlite3_bind_int64(current->statement, 2, key_integer(keys.second));
+        }
+        break;
+      case plan_rowid:
+        sqlite3_bind_value(current->statement, 1, argv[0]);
+        break;
+    }
+    return phonetic_next(cursor);
+  }
+
+  int phonetic_eof(sqlite3_vtab_cursor* cursor)
+  {
+    return reinterpret_cast<phonetic_cursor*>(cursor)->eof;
+  }
+
+  int phonetic_column(sqlite3_vtab_cursor* cursor, sqlite3_context* context, int column)
+  {
+    auto current = reinterpret_cast<phonetic_cursor*>(cursor);
+    sqlite3_value* name = sqlite3_column_value(current->statement, 1);
+    if (column == column_name)
+      sqlite3_result_value(context, name);
+    else if (sqlite3_value_type(name) != SQLITE_NULL)
+    {
+      const auto keys = dm::double_metaphone(text_arg(name));
+      const auto& key = column == column_primary ? keys.first : keys.second;
+      sqlite3_result_text(context, key.data(), int(key.length()), SQLITE_TRANSIENT);
+    }
+    return SQLITE_OK;
+  }
+
+  int phonetic_rowid(sqlite3_vtab_cursor* cursor, sqlite3_int64* rowid)
+  {
+    *rowid = sqlite3_column_int64(reinterpret_cast<phonetic_cursor*>(cursor)->statement, 0);
+    return SQLITE_OK;
+  }
+
+  int phonetic_update(sqlite3_vtab* vtab, int argc, sqlite3_value** argv, sqlite3_int64* rowid)
+  {
+    auto table = reinterpret_cast<phonetic_table*>(vtab);
+
+    /* delete, or the old row of an update */
+    if (sqlite3_value_type(argv[0]) != SQLITE_NULL)
+    {
+      const int result = table->remove(sqlite3_value_int64(argv[0]));
+      if (result != SQLITE_OK || argc == 1)
+        return result;
+    }
+
+    /* the keys are computed from the name, anything written to them is ignored */
+    return table->insert(argv[1], argv[2 + column_name], rowid);
+  }
+
+  int phonetic_find_function(sqlite3_vtab* vtab,
+                             int argc,
+                             const char* name,
+                             void (**function)(sqlite3_context*, int, sqlite3_value**),
+                             void** user_data)
+  {
+    if (argc == 2 && sqlite3_stricmp(name, "sounds_like") == 0)
+    {
+      *function = sounds_like_function;
+      *user_data = nullptr;
+      return SQLITE_INDEX_CONSTRAINT_FUNCTION;
+    }
+    return 0;
+  }
+
+  int phonetic_shadow_name(const char* suffix)
+  {
+    return sqlite3_stricmp(suffix, "data") == 0 || sqlite3_stricmp(suffix, "keys") == 0;
+  }
+
+  sqlite3_module phonetic_module()
+  {
+    sqlite3_module module;
+    std::memset(&module, 0, sizeof(module));
+    module.iVersion = 3;
+    module.xCreate = phonetic_create;
+    module.xConnect = phonetic_reconnect;
+    module.xBestIndex = phonetic_best_index;
+    module.xDisconnect = phonetic_disconnect;
+    module.xDestroy = phonetic_destroy;
+    module.xOpen = phonetic_open;
+    module.xClose = phonetic_close;
+    module.xFilter = phonetic_filter;
+    module.xNext = phonetic_next;
+    module.xEof = phonetic_eof;
+    module.xColumn = phonetic_column;
+    module.xRowid = phonetic_rowid;
+    module.xUpdate = phonetic_update;
+    module.xFindFunction = phonetic_find_function;
+    module.xShadowName = phonetic_shadow_name;
+    return module;
+  }
+}
+
+extern "C"
+#ifdef _WIN32
+__declspec(dllexport)
+#endif
+int sqlite3_dmetaphone_init(sqlite3* db, char** error, const sqlite3_api_routines* api)
+{
+  SQLITE_EXTENSION_INIT2(api);
+
+  static int alternate = 1;
+  static const sqlite3_module module = phonetic_module();
+  const int flags = SQLITE_UTF8 | SQLITE_DETERMINISTIC | SQLITE_INNOCUOUS;
+  int result = SQLITE_OK;
+  if (result == SQLITE_OK)
+    result = sqlite3_create_function(db, "dmetaphone", 1, flags, nullptr, dmetaphone_function, nullptr, nullptr);
+  if (result == SQLITE_OK)
+    result = sqlite3_create_function(db, "dmetaphone_alt", 1, flags, &alternate, dmetaphone_function, nullptr, nullptr);
+  if (result == SQLITE_OK)
+    result = sqlite3_create_function(db, "dmetaphone_key", 1, flags, nullptr, dmetaphone_key_function, nullptr, nullptr);
+  if (result == SQLITE_OK)
+    result = sqlite3_create_function(db, "dmetaphone_alt_key", 1, flags, &alternate, dmetaphone_key_function, nullptr, nullptr);
+  if (result == SQLITE_OK)
+    result = sqlite3_create_function(db, "sounds_like", 2, flags, nullptr, sounds_like_function, nullptr, nullptr);
+  if (result == SQLITE_OK)
+    result = sqlite3_create_module(db, "dmetaphone", &module, nullptr);
+  return result;
+}
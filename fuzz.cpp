@@ -0,0 +1,138 @@
+//
+//  fuzz.cpp
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+
+//  fuzz: checks the encoder on arbitrary bytes, aborting on the first broken invariant.
+//
+//    With libFuzzer, starting from the seeds in fuzz_corpus:
+//      clang++ -std=c++11 -g -O1 -fsanitize=fuzzer,address,undefined -DDM_LIBFUZZER fuzz.cpp -ofuzz && ./fuzz fuzz_corpus
+//
+//    Without, replaying files and directories of inputs:
+//      g++ -std=c++11 -g -O1 -fsanitize=address,undefined fuzz.cpp -ofuzz && ./fuzz fuzz_corpus
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+
+#include "double_metaphone_key_pair.h"
+#include "double_metaphone_packed.h"
+
+namespace
+{
+  void check(bool invariant, const char* what)
+  {
+    if (!invariant)
+    {
+      std::fprintf(stderr, "fuzz: %s\n", what);
+      std::abort();
+    }
+  }
+
+  bool starts_with(const std::string& str, const std::string& prefix)
+  {
+    return str.compare(0, prefix.size(), prefix) == 0;
+  }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+  const char* word = reinterpret_cast<const char*>(data);
+  const std::string str(word, size);
+
+  /* every overload agrees with the pair */
+  const auto keys = dm::double_metaphone(str);
+  std::pair<std::string, std::string> parts;
+  dm::double_metaphone(word, size, [&parts, size](const char* metaph1, const char* metaph2, size_t start, size_t len)
+                       {
+                         check(start < size && len, "part outside the word");
+                         if (metaph1)
+                           parts.first += metaph1;
+                         if (metaph2)
+                           parts.second += metaph2;
+                       });
+  check(parts == keys, "callback keys differ from the pair");
+  check(dm::double_metaphone_packed(word, size) == dm::packed_keys(dm::pack_key(keys.first), dm::pack_key(keys.second)), "packed keys differ from the pair");
+
+  const auto pair = dm::double_metaphone_key_pair(str);
+  check(starts_with(keys.first, pair.first()) && starts_with(keys.second, pair.second()), "key pair isn't a prefix of the pair");
+  check(pair.overflowed() == (keys.first.size() > dm::key_pair::capacity || keys.second.size() > dm::key_pair::capacity), "key pair overflow");
+
+  /* a length limit is the same as truncating the word at a character */
+  const std::size_t max_length = size / 2;
+  const std::size_t cut = dm::utf8_prefix(word, size, max_length);
+  auto continues = [word](std::size_t at) { return (word[at] & 0xC0) == 0x80; };
+  const bool invalid = cut == max_length && cut >= 4 && continues(cut) && continues(cut - 1) && continues(cut - 2) && continues(cut - 3);
+  check(cut <= max_length && (cut == 0 || cut == size || !continues(cut) || invalid), "cut inside a character");
+  check(dm::double_metaphone(str, dm::encode_limits(max_length)) == dm::double_metaphone(str.substr(0, cut)), "length limit differs from truncating");
+
+  /* a step limit gives prefixes of the keys */
+  const auto stepped = dm::double_metaphone(str, dm::encode_limits(-1, size / 3));
+  check(starts_with(keys.first, stepped.first) && starts_with(keys.second, stepped.second), "step limit isn't a prefix");
+  return 0;
+}
+
+#ifndef DM_LIBFUZZER
+namespace
+{
+  void replay(const std::string& path)
+  {
+    if (DIR* dir = ::opendir(path.c_str()))
+    {
+      while (const dirent* entry = ::readdir(dir))
+        if (entry->d_name[0] != '.')
+          replay(path + "/" + entry->d_name);
+      ::closedir(dir);
+      return;
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+    {
+      std::fprintf(stderr, "fuzz: can't read %s\n", path.c_str());
+      std::exit(1);
+    }
+    std::vector<std::uint8_t> input;
+    std::uint8_t buffer[4096];
+    for (std::size_t read; (read = std::fread(buffer, 1, sizeof(buffer), file)) != 0;)
+      input.insert(input.end(), buffer, buffer + read);
+    std::fclose(file);
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+  }
+}
+
+int main(int argc, char** argv)
+{
+  for (int i = 1; i < argc; ++i)
+    replay(argv[i]);
+  return 0;
+}
+#endif
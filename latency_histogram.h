@@ -0,0 +1,117 @@
+//
+//  latency_histogram.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DM_LATENCY_HISTOGRAM_H
+#define DM_LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace dm
+{
+  /* HDR style histogram of latencies in nanoseconds: 16 linear buckets per power of two,
+     so any percentile is within about 6% of the true latency */
+  class latency_histogram
+  {
+  public:
+    latency_histogram(): counts_(bucket_count), count_(0), max_(0)
+    {
+    }
+
+    void record(std::uint64_t nanoseconds)
+    {
+      ++counts_[bucket_of(nanoseconds)];
+      ++count_;
+      max_ = std::max(max_, nanoseconds);
+    }
+
+    void merge(const latency_histogram& other)
+    {
+      for (std::size_t bucket = 0; bucket < bucket_count; ++bucket)
+        counts_[bucket] += other.counts_[bucket];
+      count_ += other.count_;
+      max_ = std::max(max_, other.max_);
+    }
+
+    std::uint64_t count() const
+    {
+      return count_;
+    }
+
+    std::uint64_t max() const
+    {
+      return max_;
+    }
+
+    /* latency at or under which the fraction of recordings fall, e.g. 0.99 */
+    std::uint64_t percentile(double fraction) const
+    {
+      const std::uint64_t rank = std::uint64_t(fraction * count_ + 0.5);
+      std::uint64_t seen = 0;
+      for (std::size_t bucket = 0; bucket < bucket_count; ++bucket)
+      {
+        seen += counts_[bucket];
+        if (seen >= rank && seen)
+          return std::min(upper_of(bucket), max_);
+      }
+      return max_;
+    }
+
+  private:
+    enum
+    {
+      bucket_count = 61 * 16
+    };
+
+    static std::size_t bucket_of(std::uint64_t value)
+    {
+      if (value < 16)
+        return std::size_t(value);
+      unsigned exponent = 4;
+      while (exponent < 63 && (value >> (exponent + 1)))
+        ++exponent;
+      return (exponent - 3) * 16 + ((value >> (exponent - 4)) & 15);
+    }
+
+    static std::uint64_t upper_of(std::size_t bucket)
+    {
+      if (bucket < 16)
+        return bucket;
+      const unsigned exponent = unsigned(bucket / 16 + 3);
+      const std::uint64_t width = std::uint64_t(1) << (exponent - 4);
+      return ((16 + bucket % 16) << (exponent - 4)) + width - 1;
+    }
+
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t count_;
+    std::uint64_t max_;
+  };
+}
+
+#endif
@@ -0,0 +1,28 @@
+////////////////////////////////////////////////////////////////////////////////
+// Double Metaphone (c) 1998, 1999 by Lawrence Philips
+//
+// Transcribed from the published listing for bench reference; see dmetaph.cpp.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MSTRING_H
+#define MSTRING_H
+
+class MString : public CString
+{
+        int     length, last;
+        BOOL    alternate;
+        CString primary, secondary;
+
+public:
+        MString();
+        MString(const char*);
+        MString(const CString&);
+        BOOL SlavoGermanic();
+        inline void MetaphAdd(const char* main);
+        inline void MetaphAdd(const char* main, const char* alt);
+        bool IsVowel(int at);
+        bool StringAt(int start, int length, ... );
+        void DoubleMetaphone(MString &metaph, MString &metaph2);
+};
+
+#endif
@@ -0,0 +1,126 @@
+//
+//  stdafx.h
+//
+//  Copyright (c) 2014, Pixelglow Software. All rights reserved.
+//
+
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+//  BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+//  OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+
+//  Stands in for the MFC precompiled header dmetaph.cpp and MString.h expect: the Windows BOOL and the few
+//  CString members they use, over std::string, so the reference builds anywhere for bench reference.
+
+#ifndef DM_REFERENCE_STDAFX_H
+#define DM_REFERENCE_STDAFX_H
+
+#include <cctype>
+#include <cstdarg>
+#include <cstring>
+#include <string>
+
+typedef int BOOL;
+#define TRUE 1
+#define FALSE 0
+
+class CString
+{
+public:
+  CString()
+  {
+  }
+
+  CString(const char* str): str_(str)
+  {
+  }
+
+  int GetLength() const
+  {
+    return int(std::strlen(str_.c_str()));
+  }
+
+  /* NUL past the end, where MFC would assert */
+  char GetAt(int index) const
+  {
+    return index >= 0 && std::size_t(index) < str_.size() ? str_[index] : '\0';
+  }
+
+  /* a NUL cuts the string short, as MFC's */
+  void SetAt(int index, char ch)
+  {
+    str_[index] = ch;
+    if (!ch)
+      str_.resize(index);
+  }
+
+  int Find(char ch) const
+  {
+    const auto found = str_.find(ch);
+    return found == std::string::npos ? -1 : int(found);
+  }
+
+  int Find(const char* sub) const
+  {
+    const auto found = str_.find(sub);
+    return found == std::string::npos ? -1 : int(found);
+  }
+
+  CString Mid(int first, int count) const
+  {
+    CString mid;
+    if (first < int(str_.size()))
+      mid.str_ = str_.substr(first, count);
+    return mid;
+  }
+
+  void MakeUpper()
+  {
+    for (auto& ch : str_)
+      ch = char(std::toupper(static_cast<unsigned char>(ch)));
+  }
+
+  int Insert(int index, const char* str)
+  {
+    str_.insert(std::size_t(index), str);
+    return int(str_.size());
+  }
+
+  CString& operator+=(const char* str)
+  {
+    str_ += str;
+    return *this;
+  }
+
+  operator const char*() const
+  {
+    return str_.c_str();
+  }
+
+  friend bool operator==(const CString& str1, const char* str2)
+  {
+    return str1.str_ == str2;
+  }
+
+private:
+  std::string str_;
+};
+
+#endif
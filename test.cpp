@@ -6,1234 +6,1343 @@
 //
 //
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <thread>
+#include <vector>
 
+#include "allocation_counter.h"
 #include "double_metaphone.h"
+#include "double_metaphone_arena.h"
+#include "double_metaphone_composite.h"
+#include "double_metaphone_deletion_index.h"
+#include "double_metaphone_dictionary.h"
+#include "double_metaphone_distance.h"
+#include "double_metaphone_filter.h"
+#include "double_metaphone_frames.h"
+#include "double_metaphone_interleaved.h"
+#include "double_metaphone_join.h"
+#include "double_metaphone_key_pair.h"
+#include "double_metaphone_live_index.h"
+#include "double_metaphone_mapped.h"
+#include "double_metaphone_parts.h"
+#include "double_metaphone_postings.h"
+#include "double_metaphone_prefix.h"
+#include "double_metaphone_scan.h"
+#include "double_metaphone_sort.h"
+#include "double_metaphone_spans.h"
 
-const char* tests[][3] =
+#include "test_words.h"
+
+int test_packed()
+{
+  int mismatches = 0;
+  for (auto& test : tests)
+  {
+    auto keys = dm::double_metaphone_packed(test[0]);
+    if (dm::unpack_key(keys.first) != test[1] || dm::unpack_key(keys.second) != test[2]
+        || dm::pack_key(test[1]) != keys.first || dm::packed_length(keys.first) != strlen(test[1]))
+    {
+      std::clog << "Mismatched packed " << test[0] << ": " << dm::unpack_key(keys.first) << " " << dm::unpack_key(keys.second) << "\n";
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+int test_scan()
+{
+  // odd sized column to exercise the scalar tail of the vector kernels
+  std::vector<dm::packed_key> column;
+  for (auto& test : tests)
+  {
+    column.push_back(dm::pack_key(test[1]));
+    column.push_back(dm::pack_key(test[2]));
+  }
+  column.push_back(0);
+
+  int mismatches = 0;
+  std::vector<std::uint64_t> bitmap((column.size() + 63) / 64);
+  for (auto& test : tests)
+  {
+    dm::packed_keys query(dm::pack_key(test[1]), dm::pack_key(test[2]));
+    for (auto isa : {dm::scan_isa::scalar, dm::scan_isa::avx2, dm::scan_isa::avx512})
+    {
+      std::vector<std::size_t> exact;
+      std::vector<std::size_t> prefix;
+      dm::scan_exact(column.data(), column.size(), query, exact, isa);
+      auto prefix_count = dm::scan_prefix(column.data(), column.size(), query, bitmap.data(), isa);
+      dm::bitmap_positions(bitmap.data(), column.size(), 0, prefix);
+
+      std::vector<std::size_t> expected_exact;
+      std::vector<std::size_t> expected_prefix;
+      for (std::size_t i = 0; i < column.size(); ++i)
+      {
+        auto key = dm::unpack_key(column[i]);
+        if (key == test[1] || key == test[2])
+          expected_exact.push_back(i);
+        if (key.compare(0, strlen(test[1]), test[1]) == 0 || key.compare(0, strlen(test[2]), test[2]) == 0)
+          expected_prefix.push_back(i);
+      }
+
+      if (exact != expected_exact || prefix != expected_prefix || prefix_count != prefix.size())
+      {
+        std::clog << "Mismatched scan " << test[0] << " with isa " << int(isa) << "\n";
+        ++mismatches;
+      }
+    }
+  }
+  return mismatches;
+}
+
+unsigned edit_distance(const std::string& a, const std::string& b)
+{
+  std::vector<unsigned> row(b.size() + 1);
+  for (std::size_t j = 0; j <= b.size(); ++j)
+    row[j] = unsigned(j);
+  for (std::size_t i = 1; i <= a.size(); ++i)
+  {
+    unsigned diagonal = row[0];
+    row[0] = unsigned(i);
+    for (std::size_t j = 1; j <= b.size(); ++j)
+    {
+      unsigned above = row[j];
+      row[j] = std::min(std::min(row[j] + 1, row[j - 1] + 1), diagonal + (a[i - 1] != b[j - 1]));
+      diagonal = above;
+    }
+  }
+  return row[b.size()];
+}
+
+int test_distance()
+{
+  std::vector<dm::packed_key> keys;
+  for (auto& test : tests)
+    keys.push_back(dm::pack_key(test[1]));
+
+  int mismatches = 0;
+  std::vector<std::uint8_t> distances(keys.size());
+  for (std::size_t i = 0; i < keys.size(); i += 7)
+  {
+    dm::packed_distances(keys[i], keys.data(), keys.size(), distances.data());
+    for (std::size_t j = 0; j < keys.size(); ++j)
+    {
+      auto expected = edit_distance(tests[i][1], tests[j][1]);
+      if (distances[j] != expected
+          || dm::packed_distance(keys[i], keys[j], 1) != std::min(expected, 2u)
+          || dm::packed_distance(keys[i], keys[j], 2) != std::min(expected, 3u))
+      {
+        std::clog << "Mismatched distance " << tests[i][1] << " " << tests[j][1] << ": " << int(distances[j]) << " != " << expected << "\n";
+        ++mismatches;
+      }
+    }
+  }
+  return mismatches;
+}
+
+dm::index make_test_index()
+{
+  dm::index_builder builder;
+  for (std::size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); ++i)
+    builder.add(dm::record_id(i), tests[i][0]);
+  return builder.build();
+}
+
+int test_lookup()
+{
+  auto index = make_test_index();
+
+  int mismatches = 0;
+  for (std::size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); ++i)
+    for (auto key : {tests[i][1], tests[i][2]})
+    {
+      auto ids = index.lookup(dm::pack_key(key));
+      if (!std::binary_search(ids.begin(), ids.end(), dm::record_id(i)) || !std::is_sorted(ids.begin(), ids.end()))
+      {
+        std::clog << "Mismatched lookup " << tests[i][0] << " " << key << "\n";
+        ++mismatches;
+      }
+    }
+  return mismatches;
+}
+
+int test_deletion_index()
+{
+  auto index = make_test_index();
+  dm::deletion_index deletions(index.view(), 2);
+
+  int mismatches = 0;
+  for (std::size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i += 5)
+    for (unsigned distance = 0; distance <= 2; ++distance)
+    {
+      dm::packed_keys query(dm::pack_key(tests[i][1]), dm::pack_key(tests[i][2]));
+      std::vector<std::size_t> found;
+      deletions.find(query, distance, found);
+
+      std::vector<std::size_t> expected;
+      for (std::size_t position = 0; position < index.size(); ++position)
+      {
+        auto key = dm::unpack_key(index.keys()[position]);
+        if (edit_distance(tests[i][1], key) <= distance || edit_distance(tests[i][2], key) <= distance)
+          expected.push_back(position);
+      }
+
+      if (found != expected)
+      {
+        std::clog << "Mismatched deletion index " << tests[i][0] << " within " << distance << "\n";
+        ++mismatches;
+      }
+    }
+  return mismatches;
+}
+
+int test_join()
+{
+  std::vector<std::string> left;
+  std::vector<std::string> right;
+  for (std::size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); ++i)
+  {
+    left.push_back(tests[i][0]);
+    if (i % 3 == 0)
+      right.push_back(tests[i][0]);
+  }
+
+  std::vector<std::pair<dm::record_id, dm::record_id>> expected;
+  for (std::size_t l = 0; l < left.size(); ++l)
+    for (std::size_t r = 0; r < right.size(); ++r)
+    {
+      auto left_keys = dm::double_metaphone(left[l]);
+      auto right_keys = dm::double_metaphone(right[r]);
+      if (left_keys.first == right_keys.first || left_keys.first == right_keys.second
+          || left_keys.second == right_keys.first || left_keys.second == right_keys.second)
+        expected.push_back(std::make_pair(dm::record_id(l), dm::record_id(r)));
+    }
+
+  int mismatches = 0;
+  for (int bits : {-1, 0, 4, 64})
+    for (unsigned threads : {1u, 4u})
+    {
+      dm::join_options options;
+      options.threads = threads;
+      options.partition_bits = bits;
+      auto joined = dm::phonetic_join(left.data(), left.size(), right.data(), right.size(), options);
+      std::sort(joined.pairs.begin(), joined.pairs.end());
+      if (joined.pairs != expected || joined.skipped_blocks)
+      {
+        std::clog << "Mismatched join with " << bits << " partition bits on " << threads << " threads\n";
+        ++mismatches;
+      }
+    }
+
+  dm::join_options capped;
+  capped.max_block_pairs = 0;
+  auto joined = dm::phonetic_join(left.data(), left.size(), right.data(), right.size(), capped);
+  if (!joined.pairs.empty() || joined.skipped_pairs < expected.size())
+  {
+    std::clog << "Mismatched capped join\n";
+    ++mismatches;
+  }
+
+  // a pair matching on a skipped common key and a selective key still comes from the selective one
+  std::vector<dm::packed_keys> common(11, dm::packed_keys(1, 1));
+  common.back().second = 2;
+  for (std::size_t max_block_pairs : {std::size_t(50), std::size_t(1000)})
+    for (unsigned threads : {1u, 4u})
+    {
+      dm::join_options options;
+      options.threads = threads;
+      options.max_block_pairs = max_block_pairs;
+      auto shared = dm::phonetic_join(common.data(), common.size(), common.data(), common.size(), options);
+      std::sort(shared.pairs.begin(), shared.pairs.end());
+      const auto skipped = max_block_pairs < 121;
+      const auto expected_pairs = skipped ? 1 : 121;
+      if (shared.pairs.size() != std::size_t(expected_pairs) || shared.skipped_blocks != std::size_t(skipped)
+          || std::adjacent_find(shared.pairs.begin(), shared.pairs.end()) != shared.pairs.end()
+          || (skipped && shared.pairs[0] != std::make_pair(dm::record_id(10), dm::record_id(10))))
+      {
+        std::clog << "Mismatched join of a skipped and a selective key with " << max_block_pairs << " pairs\n";
+        ++mismatches;
+      }
+    }
+  return mismatches;
+}
+
+int test_sort()
+{
+  // keys of test words with ids scattered over all their bytes
+  std::vector<dm::index::entry> entries;
+  std::uint32_t id = 1;
+  for (int round = 0; round < 250; ++round)
+    for (auto& test : tests)
+    {
+      id = id * 1664525 + 1013904223;
+      entries.push_back(dm::index::entry(dm::pack_key(test[round % 2 + 1]), id));
+    }
+
+  auto expected = entries;
+  std::sort(expected.begin(), expected.end());
+
+  int mismatches = 0;
+  for (unsigned threads : {1u, 4u})
+  {
+    auto sorted = entries;
+    dm::radix_sort(sorted, threads);
+    if (sorted != expected)
+    {
+      std::clog << "Mismatched radix sort on " << threads << " threads\n";
+      ++mismatches;
+    }
+  }
+
+  auto grouped = dm::group_by(entries, 4);
+  dm::external_sorter sorter(1024, 2);
+  for (auto& entry : entries)
+    sorter.add(entry.first, entry.second);
+  auto spilled_runs = sorter.runs();
+  auto spilled = sorter.build();
+  if (spilled_runs < 2 || spilled.keys() != grouped.keys() || spilled.offsets() != grouped.offsets() || spilled.ids() != grouped.ids())
+  {
+    std::clog << "Mismatched external sort over " << spilled_runs << " runs\n";
+    ++mismatches;
+  }
+  return mismatches;
+}
+
+int test_filter()
+{
+  auto index = make_test_index();
+  dm::key_filter filter(index);
+
+  int mismatches = 0;
+  for (auto& test : tests)
+    if (!filter.may_contain(dm::double_metaphone_packed(test[0])))
+    {
+      std::clog << "Mismatched filter " << test[0] << "\n";
+      ++mismatches;
+    }
+
+  // keys made of symbols in an order no test key has
+  std::size_t absent = 0;
+  std::size_t false_positives = 0;
+  for (dm::packed_key key = 0x1000000000000000ull; key < 0x1400000000000000ull; key += 0x0000100000000000ull)
+    if (index.find(key) == index.size())
+    {
+      ++absent;
+      false_positives += filter.may_contain(key);
+    }
+  if (false_positives * 50 > absent)
+  {
+    std::clog << "Mismatched filter with " << false_positives << " false positives in " << absent << "\n";
+    ++mismatches;
+  }
+
+  // the same bits from a view as from the index
+  dm::key_filter viewed(index.view());
+  if (viewed.blocks().size() != filter.blocks().size()
+      || std::memcmp(viewed.blocks().data(), filter.blocks().data(), filter.blocks().size() * sizeof(dm::filter_block)) != 0)
+  {
+    std::clog << "Mismatched filter of an index view\n";
+    ++mismatches;
+  }
+
+  // blocks on cache lines whatever operator new returns
+  std::vector<dm::key_filter> filters;
+  for (std::size_t count = 0; count < 2000; count += 100)
+    filters.push_back(dm::key_filter(count));
+  for (auto& sized : filters)
+    if (reinterpret_cast<std::uintptr_t>(sized.blocks().data()) % 64 != 0)
+    {
+      std::clog << "Mismatched filter alignment of " << sized.blocks().size() << " blocks\n";
+      ++mismatches;
+    }
+  return mismatches;
+}
+
+int test_live_index()
 {
-  {"ALLERTON","ALRTN","ALRTN"},
-  {"Acton","AKTN","AKTN"},
-  {"Adams","ATMS","ATMS"},
-  {"Aggar","AKR","AKR"},
-  {"Ahl","AL","AL"},
-  {"Aiken","AKN","AKN"},
-  {"Alan","ALN","ALN"},
-  {"Alcock","ALKK","ALKK"},
-  {"Alden","ALTN","ALTN"},
-  {"Aldham","ALTM","ALTM"},
-  {"Allen","ALN","ALN"},
-  {"Allerton","ALRTN","ALRTN"},
-  {"Alsop","ALSP","ALSP"},
-  {"Alwein","ALN","ALN"},
-  {"Ambler","AMPLR","AMPLR"},
-  {"Andevill","ANTFL","ANTFL"},
-  {"Andrews","ANTRS","ANTRS"},
-  {"Andreyco","ANTRK","ANTRK"},
-  {"Andriesse","ANTRS","ANTRS"},
-  {"Angier","ANJ","ANJR"},
-  {"Annabel","ANPL","ANPL"},
-  {"Anne","AN","AN"},
-  {"Anstye","ANST","ANST"},
-  {"Appling","APLNK","APLNK"},
-  {"Apuke","APK","APK"},
-  {"Arnold","ARNLT","ARNLT"},
-  {"Ashby","AXP","AXP"},
-  {"Astwood","ASTT","ASTT"},
-  {"Atkinson","ATKNSN","ATKNSN"},
-  {"Audley","ATL","ATL"},
-  {"Austin","ASTN","ASTN"},
-  {"Avenal","AFNL","AFNL"},
-  {"Ayer","AR","AR"},
-  {"Ayot","AT","AT"},
-  {"Babbitt","PPT","PPT"},
-  {"Bachelor","PXLR","PKLR"},
-  {"Bachelour","PXLR","PKLR"},
-  {"Bailey","PL","PL"},
-  {"Baivel","PFL","PFL"},
-  {"Baker","PKR","PKR"},
-  {"Baldwin","PLTN","PLTN"},
-  {"Balsley","PLSL","PLSL"},
-  {"Barber","PRPR","PRPR"},
-  {"Barker","PRKR","PRKR"},
-  {"Barlow","PRL","PRLF"},
-  {"Barnard","PRNRT","PRNRT"},
-  {"Barnes","PRNS","PRNS"},
-  {"Barnsley","PRNSL","PRNSL"},
-  {"Barouxis","PRKSS","PRKSS"},
-  {"Bartlet","PRTLT","PRTLT"},
-  {"Basley","PSL","PSL"},
-  {"Basset","PST","PST"},
-  {"Bassett","PST","PST"},
-  {"Batchlor","PXLR","PXLR"},
-  {"Bates","PTS","PTS"},
-  {"Batson","PTSN","PTSN"},
-  {"Bayes","PS","PS"},
-  {"Bayley","PL","PL"},
-  {"Beale","PL","PL"},
-  {"Beauchamp","PXMP","PKMP"},
-  {"Beauclerc","PKLRK","PKLRK"},
-  {"Beech","PX","PK"},
-  {"Beers","PRS","PRS"},
-  {"Beke","PK","PK"},
-  {"Belcher","PLXR","PLKR"},
-  {"Benjamin","PNJMN","PNJMN"},
-  {"Benningham","PNNKM","PNNKM"},
-  {"Bereford","PRFRT","PRFRT"},
-  {"Bergen","PRJN","PRKN"},
-  {"Berkeley","PRKL","PRKL"},
-  {"Berry","PR","PR"},
-  {"Besse","PS","PS"},
-  {"Bessey","PS","PS"},
-  {"Bessiles","PSLS","PSLS"},
-  {"Bigelow","PJL","PKLF"},
-  {"Bigg","PK","PK"},
-  {"Bigod","PKT","PKT"},
-  {"Billings","PLNKS","PLNKS"},
-  {"Bimper","PMPR","PMPR"},
-  {"Binker","PNKR","PNKR"},
-  {"Birdsill","PRTSL","PRTSL"},
-  {"Bishop","PXP","PXP"},
-  {"Black","PLK","PLK"},
-  {"Blagge","PLK","PLK"},
-  {"Blake","PLK","PLK"},
-  {"Blanck","PLNK","PLNK"},
-  {"Bledsoe","PLTS","PLTS"},
-  {"Blennerhasset","PLNRST","PLNRST"},
-  {"Blessing","PLSNK","PLSNK"},
-  {"Blewett","PLT","PLT"},
-  {"Bloctgoed","PLKTKT","PLKTKT"},
-  {"Bloetgoet","PLTKT","PLTKT"},
-  {"Bloodgood","PLTKT","PLTKT"},
-  {"Blossom","PLSM","PLSM"},
-  {"Blount","PLNT","PLNT"},
-  {"Bodine","PTN","PTN"},
-  {"Bodman","PTMN","PTMN"},
-  {"BonCoeur","PNKR","PNKR"},
-  {"Bond","PNT","PNT"},
-  {"Boscawen","PSKN","PSKN"},
-  {"Bosworth","PSR0","PSRT"},
-  {"Bouchier","PX","PKR"},
-  {"Bowne","PN","PN"},
-  {"Bradbury","PRTPR","PRTPR"},
-  {"Bradder","PRTR","PRTR"},
-  {"Bradford","PRTFRT","PRTFRT"},
-  {"Bradstreet","PRTSTRT","PRTSTRT"},
-  {"Braham","PRHM","PRHM"},
-  {"Brailsford","PRLSFRT","PRLSFRT"},
-  {"Brainard","PRNRT","PRNRT"},
-  {"Brandish","PRNTX","PRNTX"},
-  {"Braun","PRN","PRN"},
-  {"Brecc","PRK","PRK"},
-  {"Brent","PRNT","PRNT"},
-  {"Brenton","PRNTN","PRNTN"},
-  {"Briggs","PRKS","PRKS"},
-  {"Brigham","PRM","PRM"},
-  {"Brobst","PRPST","PRPST"},
-  {"Brome","PRM","PRM"},
-  {"Bronson","PRNSN","PRNSN"},
-  {"Brooks","PRKS","PRKS"},
-  {"Brouillard","PRLRT","PRLRT"},
-  {"Brown","PRN","PRN"},
-  {"Browne","PRN","PRN"},
-  {"Brownell","PRNL","PRNL"},
-  {"Bruley","PRL","PRL"},
-  {"Bryant","PRNT","PRNT"},
-  {"Brzozowski","PRSSSK","PRTSTSFSK"},
-  {"Buide","PT","PT"},
-  {"Bulmer","PLMR","PLMR"},
-  {"Bunker","PNKR","PNKR"},
-  {"Burden","PRTN","PRTN"},
-  {"Burge","PRJ","PRK"},
-  {"Burgoyne","PRKN","PRKN"},
-  {"Burke","PRK","PRK"},
-  {"Burnett","PRNT","PRNT"},
-  {"Burpee","PRP","PRP"},
-  {"Bursley","PRSL","PRSL"},
-  {"Burton","PRTN","PRTN"},
-  {"Bushnell","PXNL","PXNL"},
-  {"Buss","PS","PS"},
-  {"Buswell","PSL","PSL"},
-  {"Butler","PTLR","PTLR"},
-  {"Calkin","KLKN","KLKN"},
-  {"Canada","KNT","KNT"},
-  {"Canmore","KNMR","KNMR"},
-  {"Canney","KN","KN"},
-  {"Capet","KPT","KPT"},
-  {"Card","KRT","KRT"},
-  {"Carman","KRMN","KRMN"},
-  {"Carpenter","KRPNTR","KRPNTR"},
-  {"Cartwright","KRTRT","KRTRT"},
-  {"Casey","KS","KS"},
-  {"Catterfield","KTRFLT","KTRFLT"},
-  {"Ceeley","SL","SL"},
-  {"Chambers","XMPRS","XMPRS"},
-  {"Champion","XMPN","XMPN"},
-  {"Chapman","XPMN","XPMN"},
-  {"Chase","XS","XS"},
-  {"Cheney","XN","XN"},
-  {"Chetwynd","XTNT","XTNT"},
-  {"Chevalier","XFL","XFLR"},
-  {"Chillingsworth","XLNKSR0","XLNKSRT"},
-  {"Christie","KRST","KRST"},
-  {"Chubbuck","XPK","XPK"},
-  {"Church","XRX","XRK"},
-  {"Clark","KLRK","KLRK"},
-  {"Clarke","KLRK","KLRK"},
-  {"Cleare","KLR","KLR"},
-  {"Clement","KLMNT","KLMNT"},
-  {"Clerke","KLRK","KLRK"},
-  {"Clibben","KLPN","KLPN"},
-  {"Clifford","KLFRT","KLFRT"},
-  {"Clivedon","KLFTN","KLFTN"},
-  {"Close","KLS","KLS"},
-  {"Clothilde","KL0LT","KLTLT"},
-  {"Cobb","KP","KP"},
-  {"Coburn","KPRN","KPRN"},
-  {"Coburne","KPRN","KPRN"},
-  {"Cocke","KK","KK"},
-  {"Coffin","KFN","KFN"},
-  {"Coffyn","KFN","KFN"},
-  {"Colborne","KLPRN","KLPRN"},
-  {"Colby","KLP","KLP"},
-  {"Cole","KL","KL"},
-  {"Coleman","KLMN","KLMN"},
-  {"Collier","KL","KLR"},
-  {"Compton","KMPTN","KMPTN"},
-  {"Cone","KN","KN"},
-  {"Cook","KK","KK"},
-  {"Cooke","KK","KK"},
-  {"Cooper","KPR","KPR"},
-  {"Copperthwaite","KPR0T","KPRTT"},
-  {"Corbet","KRPT","KRPT"},
-  {"Corell","KRL","KRL"},
-  {"Corey","KR","KR"},
-  {"Corlies","KRLS","KRLS"},
-  {"Corneliszen","KRNLSN","KRNLXN"},
-  {"Cornelius","KRNLS","KRNLS"},
-  {"Cornwallis","KRNLS","KRNLS"},
-  {"Cosgrove","KSKRF","KSKRF"},
-  {"Count of Brionne","KNTFPRN","KNTFPRN"},
-  {"Covill","KFL","KFL"},
-  {"Cowperthwaite","KPR0T","KPRTT"},
-  {"Cowperwaite","KPRT","KPRT"},
-  {"Crane","KRN","KRN"},
-  {"Creagmile","KRKML","KRKML"},
-  {"Crew","KR","KRF"},
-  {"Crispin","KRSPN","KRSPN"},
-  {"Crocker","KRKR","KRKR"},
-  {"Crockett","KRKT","KRKT"},
-  {"Crosby","KRSP","KRSP"},
-  {"Crump","KRMP","KRMP"},
-  {"Cunningham","KNNKM","KNNKM"},
-  {"Curtis","KRTS","KRTS"},
-  {"Cutha","K0","KT"},
-  {"Cutter","KTR","KTR"},
-  {"D'Aubigny","TPN","TPKN"},
-  {"DAVIS","TFS","TFS"},
-  {"Dabinott","TPNT","TPNT"},
-  {"Dacre","TKR","TKR"},
-  {"Daggett","TKT","TKT"},
-  {"Danvers","TNFRS","TNFRS"},
-  {"Darcy","TRS","TRS"},
-  {"Davis","TFS","TFS"},
-  {"Dawn","TN","TN"},
-  {"Dawson","TSN","TSN"},
-  {"Day","T","T"},
-  {"Daye","T","T"},
-  {"DeGrenier","TKRN","TKRNR"},
-  {"Dean","TN","TN"},
-  {"Deekindaugh","TKNT","TKNT"},
-  {"Dennis","TNS","TNS"},
-  {"Denny","TN","TN"},
-  {"Denton","TNTN","TNTN"},
-  {"Desborough","TSPRF","TSPRF"},
-  {"Despenser","TSPNSR","TSPNSR"},
-  {"Deverill","TFRL","TFRL"},
-  {"Devine","TFN","TFN"},
-  {"Dexter","TKSTR","TKSTR"},
-  {"Dillaway","TL","TL"},
-  {"Dimmick","TMK","TMK"},
-  {"Dinan","TNN","TNN"},
-  {"Dix","TKS","TKS"},
-  {"Doggett","TKT","TKT"},
-  {"Donahue","TNH","TNH"},
-  {"Dorfman","TRFMN","TRFMN"},
-  {"Dorris","TRS","TRS"},
-  {"Dow","T","TF"},
-  {"Downey","TN","TN"},
-  {"Downing","TNNK","TNNK"},
-  {"Dowsett","TST","TST"},
-  {"Duck?","TK","TK"},
-  {"Dudley","TTL","TTL"},
-  {"Duffy","TF","TF"},
-  {"Dunn","TN","TN"},
-  {"Dunsterville","TNSTRFL","TNSTRFL"},
-  {"Durrant","TRNT","TRNT"},
-  {"Durrin","TRN","TRN"},
-  {"Dustin","TSTN","TSTN"},
-  {"Duston","TSTN","TSTN"},
-  {"Eames","AMS","AMS"},
-  {"Early","ARL","ARL"},
-  {"Easty","AST","AST"},
-  {"Ebbett","APT","APT"},
-  {"Eberbach","APRPK","APRPK"},
-  {"Eberhard","APRRT","APRRT"},
-  {"Eddy","AT","AT"},
-  {"Edenden","ATNTN","ATNTN"},
-  {"Edwards","ATRTS","ATRTS"},
-  {"Eglinton","AKLNTN","ALNTN"},
-  {"Eliot","ALT","ALT"},
-  {"Elizabeth","ALSP0","ALSPT"},
-  {"Ellis","ALS","ALS"},
-  {"Ellison","ALSN","ALSN"},
-  {"Ellot","ALT","ALT"},
-  {"Elny","ALN","ALN"},
-  {"Elsner","ALSNR","ALSNR"},
-  {"Emerson","AMRSN","AMRSN"},
-  {"Empson","AMPSN","AMPSN"},
-  {"Est","AST","AST"},
-  {"Estabrook","ASTPRK","ASTPRK"},
-  {"Estes","ASTS","ASTS"},
-  {"Estey","AST","AST"},
-  {"Evans","AFNS","AFNS"},
-  {"Fallowell","FLL","FLL"},
-  {"Farnsworth","FRNSR0","FRNSRT"},
-  {"Feake","FK","FK"},
-  {"Feke","FK","FK"},
-  {"Fellows","FLS","FLS"},
-  {"Fettiplace","FTPLS","FTPLS"},
-  {"Finney","FN","FN"},
-  {"Fischer","FXR","FSKR"},
-  {"Fisher","FXR","FXR"},
-  {"Fisk","FSK","FSK"},
-  {"Fiske","FSK","FSK"},
-  {"Fletcher","FLXR","FLXR"},
-  {"Folger","FLKR","FLJR"},
-  {"Foliot","FLT","FLT"},
-  {"Folyot","FLT","FLT"},
-  {"Fones","FNS","FNS"},
-  {"Fordham","FRTM","FRTM"},
-  {"Forstner","FRSTNR","FRSTNR"},
-  {"Fosten","FSTN","FSTN"},
-  {"Foster","FSTR","FSTR"},
-  {"Foulke","FLK","FLK"},
-  {"Fowler","FLR","FLR"},
-  {"Foxwell","FKSL","FKSL"},
-  {"Fraley","FRL","FRL"},
-  {"Franceys","FRNSS","FRNSS"},
-  {"Franke","FRNK","FRNK"},
-  {"Frascella","FRSL","FRSL"},
-  {"Frazer","FRSR","FRSR"},
-  {"Fredd","FRT","FRT"},
-  {"Freeman","FRMN","FRMN"},
-  {"French","FRNX","FRNK"},
-  {"Freville","FRFL","FRFL"},
-  {"Frey","FR","FR"},
-  {"Frick","FRK","FRK"},
-  {"Frier","FR","FRR"},
-  {"Froe","FR","FR"},
-  {"Frorer","FRRR","FRRR"},
-  {"Frost","FRST","FRST"},
-  {"Frothingham","FR0NKM","FRTNKM"},
-  {"Fry","FR","FR"},
-  {"Gaffney","KFN","KFN"},
-  {"Gage","KJ","KK"},
-  {"Gallion","KLN","KLN"},
-  {"Gallishan","KLXN","KLXN"},
-  {"Gamble","KMPL","KMPL"},
-  {"Garbrand","KRPRNT","KRPRNT"},
-  {"Gardner","KRTNR","KRTNR"},
-  {"Garrett","KRT","KRT"},
-  {"Gassner","KSNR","KSNR"},
-  {"Gater","KTR","KTR"},
-  {"Gaunt","KNT","KNT"},
-  {"Gayer","KR","KR"},
-  {"Gerken","KRKN","JRKN"},
-  {"Gerritsen","KRTSN","JRTSN"},
-  {"Gibbs","KPS","JPS"},
-  {"Giffard","JFRT","KFRT"},
-  {"Gilbert","KLPRT","JLPRT"},
-  {"Gill","KL","JL"},
-  {"Gilman","KLMN","JLMN"},
-  {"Glass","KLS","KLS"},
-  {"Goddard","KTRT","KTRT"},
-  {"Godfrey","KTFR","KTFR"},
-  {"Godwin","KTN","KTN"},
-  {"Goodale","KTL","KTL"},
-  {"Goodnow","KTN","KTNF"},
-  {"Gorham","KRM","KRM"},
-  {"Goseline","KSLN","KSLN"},
-  {"Gott","KT","KT"},
-  {"Gould","KLT","KLT"},
-  {"Grafton","KRFTN","KRFTN"},
-  {"Grant","KRNT","KRNT"},
-  {"Gray","KR","KR"},
-  {"Green","KRN","KRN"},
-  {"Griffin","KRFN","KRFN"},
-  {"Grill","KRL","KRL"},
-  {"Grim","KRM","KRM"},
-  {"Grisgonelle","KRSKNL","KRSKNL"},
-  {"Gross","KRS","KRS"},
-  {"Guba","KP","KP"},
-  {"Gybbes","KPS","JPS"},
-  {"Haburne","HPRN","HPRN"},
-  {"Hackburne","HKPRN","HKPRN"},
-  {"Haddon?","HTN","HTN"},
-  {"Haines","HNS","HNS"},
-  {"Hale","HL","HL"},
-  {"Hall","HL","HL"},
-  {"Hallet","HLT","HLT"},
-  {"Hallock","HLK","HLK"},
-  {"Halstead","HLSTT","HLSTT"},
-  {"Hammond","HMNT","HMNT"},
-  {"Hance","HNS","HNS"},
-  {"Handy","HNT","HNT"},
-  {"Hanson","HNSN","HNSN"},
-  {"Harasek","HRSK","HRSK"},
-  {"Harcourt","HRKRT","HRKRT"},
-  {"Hardy","HRT","HRT"},
-  {"Harlock","HRLK","HRLK"},
-  {"Harris","HRS","HRS"},
-  {"Hartley","HRTL","HRTL"},
-  {"Harvey","HRF","HRF"},
-  {"Harvie","HRF","HRF"},
-  {"Harwood","HRT","HRT"},
-  {"Hathaway","H0","HT"},
-  {"Haukeness","HKNS","HKNS"},
-  {"Hawkes","HKS","HKS"},
-  {"Hawkhurst","HKRST","HKRST"},
-  {"Hawkins","HKNS","HKNS"},
-  {"Hawley","HL","HL"},
-  {"Heald","HLT","HLT"},
-  {"Helsdon","HLSTN","HLSTN"},
-  {"Hemenway","HMN","HMN"},
-  {"Hemmenway","HMN","HMN"},
-  {"Henck","HNK","HNK"},
-  {"Henderson","HNTRSN","HNTRSN"},
-  {"Hendricks","HNTRKS","HNTRKS"},
-  {"Hersey","HRS","HRS"},
-  {"Hewes","HS","HS"},
-  {"Heyman","HMN","HMN"},
-  {"Hicks","HKS","HKS"},
-  {"Hidden","HTN","HTN"},
-  {"Higgs","HKS","HKS"},
-  {"Hill","HL","HL"},
-  {"Hills","HLS","HLS"},
-  {"Hinckley","HNKL","HNKL"},
-  {"Hipwell","HPL","HPL"},
-  {"Hobart","HPRT","HPRT"},
-  {"Hoben","HPN","HPN"},
-  {"Hoffmann","HFMN","HFMN"},
-  {"Hogan","HKN","HKN"},
-  {"Holmes","HLMS","HLMS"},
-  {"Hoo","H","H"},
-  {"Hooker","HKR","HKR"},
-  {"Hopcott","HPKT","HPKT"},
-  {"Hopkins","HPKNS","HPKNS"},
-  {"Hopkinson","HPKNSN","HPKNSN"},
-  {"Hornsey","HRNS","HRNS"},
-  {"Houckgeest","HKJST","HKKST"},
-  {"Hough","H","H"},
-  {"Houstin","HSTN","HSTN"},
-  {"How","H","HF"},
-  {"Howe","H","H"},
-  {"Howland","HLNT","HLNT"},
-  {"Hubner","HPNR","HPNR"},
-  {"Hudnut","HTNT","HTNT"},
-  {"Hughes","HS","HS"},
-  {"Hull","HL","HL"},
-  {"Hulme","HLM","HLM"},
-  {"Hume","HM","HM"},
-  {"Hundertumark","HNTRTMRK","HNTRTMRK"},
-  {"Hundley","HNTL","HNTL"},
-  {"Hungerford","HNKRFRT","HNJRFRT"},
-  {"Hunt","HNT","HNT"},
-  {"Hurst","HRST","HRST"},
-  {"Husbands","HSPNTS","HSPNTS"},
-  {"Hussey","HS","HS"},
-  {"Husted","HSTT","HSTT"},
-  {"Hutchins","HXNS","HXNS"},
-  {"Hutchinson","HXNSN","HXNSN"},
-  {"Huttinger","HTNKR","HTNJR"},
-  {"Huybertsen","HPRTSN","HPRTSN"},
-  {"Iddenden","ATNTN","ATNTN"},
-  {"Ingraham","ANKRHM","ANKRHM"},
-  {"Ives","AFS","AFS"},
-  {"Jackson","JKSN","AKSN"},
-  {"Jacob","JKP","AKP"},
-  {"Jans","JNS","ANS"},
-  {"Jenkins","JNKNS","ANKNS"},
-  {"Jewett","JT","AT"},
-  {"Jewitt","JT","AT"},
-  {"Johnson","JNSN","ANSN"},
-  {"Jones","JNS","ANS"},
-  {"Josephine","JSFN","HSFN"},
-  {"Judd","JT","AT"},
-  {"June","JN","AN"},
-  {"Kamarowska","KMRSK","KMRSK"},
-  {"Kay","K","K"},
-  {"Kelley","KL","KL"},
-  {"Kelly","KL","KL"},
-  {"Keymber","KMPR","KMPR"},
-  {"Keynes","KNS","KNS"},
-  {"Kilham","KLM","KLM"},
-  {"Kim","KM","KM"},
-  {"Kimball","KMPL","KMPL"},
-  {"King","KNK","KNK"},
-  {"Kinsey","KNS","KNS"},
-  {"Kirk","KRK","KRK"},
-  {"Kirton","KRTN","KRTN"},
-  {"Kistler","KSTLR","KSTLR"},
-  {"Kitchen","KXN","KXN"},
-  {"Kitson","KTSN","KTSN"},
-  {"Klett","KLT","KLT"},
-  {"Kline","KLN","KLN"},
-  {"Knapp","NP","NP"},
-  {"Knight","NT","NT"},
-  {"Knote","NT","NT"},
-  {"Knott","NT","NT"},
-  {"Knox","NKS","NKS"},
-  {"Koeller","KLR","KLR"},
-  {"La Pointe","LPNT","LPNT"},
-  {"LaPlante","LPLNT","LPLNT"},
-  {"Laimbeer","LMPR","LMPR"},
-  {"Lamb","LMP","LMP"},
-  {"Lambertson","LMPRTSN","LMPRTSN"},
-  {"Lancto","LNKT","LNKT"},
-  {"Landry","LNTR","LNTR"},
-  {"Lane","LN","LN"},
-  {"Langendyck","LNJNTK","LNKNTK"},
-  {"Langer","LNKR","LNJR"},
-  {"Langford","LNKFRT","LNKFRT"},
-  {"Lantersee","LNTRS","LNTRS"},
-  {"Laquer","LKR","LKR"},
-  {"Larkin","LRKN","LRKN"},
-  {"Latham","LTM","LTM"},
-  {"Lathrop","L0RP","LTRP"},
-  {"Lauter","LTR","LTR"},
-  {"Lawrence","LRNS","LRNS"},
-  {"Leach","LX","LK"},
-  {"Leager","LKR","LJR"},
-  {"Learned","LRNT","LRNT"},
-  {"Leavitt","LFT","LFT"},
-  {"Lee","L","L"},
-  {"Leete","LT","LT"},
-  {"Leggett","LKT","LKT"},
-  {"Leland","LLNT","LLNT"},
-  {"Leonard","LNRT","LNRT"},
-  {"Lester","LSTR","LSTR"},
-  {"Lestrange","LSTRNJ","LSTRNK"},
-  {"Lethem","L0M","LTM"},
-  {"Levine","LFN","LFN"},
-  {"Lewes","LS","LS"},
-  {"Lewis","LS","LS"},
-  {"Lincoln","LNKLN","LNKLN"},
-  {"Lindsey","LNTS","LNTS"},
-  {"Linher","LNR","LNR"},
-  {"Lippet","LPT","LPT"},
-  {"Lippincott","LPNKT","LPNKT"},
-  {"Lockwood","LKT","LKT"},
-  {"Loines","LNS","LNS"},
-  {"Lombard","LMPRT","LMPRT"},
-  {"Long","LNK","LNK"},
-  {"Longespee","LNJSP","LNKSP"},
-  {"Look","LK","LK"},
-  {"Lounsberry","LNSPR","LNSPR"},
-  {"Lounsbury","LNSPR","LNSPR"},
-  {"Louthe","L0","LT"},
-  {"Loveyne","LFN","LFN"},
-  {"Lowe","L","L"},
-  {"Ludlam","LTLM","LTLM"},
-  {"Lumbard","LMPRT","LMPRT"},
-  {"Lund","LNT","LNT"},
-  {"Luno","LN","LN"},
-  {"Lutz","LTS","LTS"},
-  {"Lydia","LT","LT"},
-  {"Lynne","LN","LN"},
-  {"Lyon","LN","LN"},
-  {"MacAlpin","MKLPN","MKLPN"},
-  {"MacBricc","MKPRK","MKPRK"},
-  {"MacCrinan","MKRNN","MKRNN"},
-  {"MacKenneth","MKN0","MKNT"},
-  {"MacMael nam Bo","MKMLNMP","MKMLNMP"},
-  {"MacMurchada","MKMRXT","MKMRKT"},
-  {"Macomber","MKMPR","MKMPR"},
-  {"Macy","MS","MS"},
-  {"Magnus","MNS","MKNS"},
-  {"Mahien","MHN","MHN"},
-  {"Malmains","MLMNS","MLMNS"},
-  {"Malory","MLR","MLR"},
-  {"Mancinelli","MNSNL","MNSNL"},
-  {"Mancini","MNSN","MNSN"},
-  {"Mann","MN","MN"},
-  {"Manning","MNNK","MNNK"},
-  {"Manter","MNTR","MNTR"},
-  {"Marion","MRN","MRN"},
-  {"Marley","MRL","MRL"},
-  {"Marmion","MRMN","MRMN"},
-  {"Marquart","MRKRT","MRKRT"},
-  {"Marsh","MRX","MRX"},
-  {"Marshal","MRXL","MRXL"},
-  {"Marshall","MRXL","MRXL"},
-  {"Martel","MRTL","MRTL"},
-  {"Martha","MR0","MRT"},
-  {"Martin","MRTN","MRTN"},
-  {"Marturano","MRTRN","MRTRN"},
-  {"Marvin","MRFN","MRFN"},
-  {"Mary","MR","MR"},
-  {"Mason","MSN","MSN"},
-  {"Maxwell","MKSL","MKSL"},
-  {"Mayhew","MH","MHF"},
-  {"McAllaster","MKLSTR","MKLSTR"},
-  {"McAllister","MKLSTR","MKLSTR"},
-  {"McConnell","MKNL","MKNL"},
-  {"McFarland","MKFRLNT","MKFRLNT"},
-  {"McIlroy","MSLR","MSLR"},
-  {"McNair","MKNR","MKNR"},
-  {"McNair-Landry","MKNRLNTR","MKNRLNTR"},
-  {"McRaven","MKRFN","MKRFN"},
-  {"Mead","MT","MT"},
-  {"Meade","MT","MT"},
-  {"Meck","MK","MK"},
-  {"Melton","MLTN","MLTN"},
-  {"Mendenhall","MNTNL","MNTNL"},
-  {"Mering","MRNK","MRNK"},
-  {"Merrick","MRK","MRK"},
-  {"Merry","MR","MR"},
-  {"Mighill","ML","ML"},
-  {"Miller","MLR","MLR"},
-  {"Milton","MLTN","MLTN"},
-  {"Mohun","MHN","MHN"},
-  {"Montague","MNTK","MNTK"},
-  {"Montboucher","MNTPXR","MNTPKR"},
-  {"Moore","MR","MR"},
-  {"Morrel","MRL","MRL"},
-  {"Morrill","MRL","MRL"},
-  {"Morris","MRS","MRS"},
-  {"Morton","MRTN","MRTN"},
-  {"Moton","MTN","MTN"},
-  {"Muir","MR","MR"},
-  {"Mulferd","MLFRT","MLFRT"},
-  {"Mullins","MLNS","MLNS"},
-  {"Mulso","MLS","MLS"},
-  {"Munger","MNKR","MNJR"},
-  {"Munt","MNT","MNT"},
-  {"Murchad","MRXT","MRKT"},
-  {"Murdock","MRTK","MRTK"},
-  {"Murray","MR","MR"},
-  {"Muskett","MSKT","MSKT"},
-  {"Myers","MRS","MRS"},
-  {"Myrick","MRK","MRK"},
-  {"NORRIS","NRS","NRS"},
-  {"Nayle","NL","NL"},
-  {"Newcomb","NKMP","NKMP"},
-  {"Newcomb(e)","NKMP","NKMP"},
-  {"Newkirk","NKRK","NKRK"},
-  {"Newton","NTN","NTN"},
-  {"Niles","NLS","NLS"},
-  {"Noble","NPL","NPL"},
-  {"Noel","NL","NL"},
-  {"Northend","NR0NT","NRTNT"},
-  {"Norton","NRTN","NRTN"},
-  {"Nutter","NTR","NTR"},
-  {"Odding","ATNK","ATNK"},
-  {"Odenbaugh","ATNP","ATNP"},
-  {"Ogborn","AKPRN","AKPRN"},
-  {"Oppenheimer","APNMR","APNMR"},
-  {"Otis","ATS","ATS"},
-  {"Oviatt","AFT","AFT"},
-  {"PRUST?","PRST","PRST"},
-  {"Paddock","PTK","PTK"},
-  {"Page","PJ","PK"},
-  {"Paine","PN","PN"},
-  {"Paist","PST","PST"},
-  {"Palmer","PLMR","PLMR"},
-  {"Park","PRK","PRK"},
-  {"Parker","PRKR","PRKR"},
-  {"Parkhurst","PRKRST","PRKRST"},
-  {"Parrat","PRT","PRT"},
-  {"Parsons","PRSNS","PRSNS"},
-  {"Partridge","PRTRJ","PRTRJ"},
-  {"Pashley","PXL","PXL"},
-  {"Pasley","PSL","PSL"},
-  {"Patrick","PTRK","PTRK"},
-  {"Pattee","PT","PT"},
-  {"Patten","PTN","PTN"},
-  {"Pawley","PL","PL"},
-  {"Payne","PN","PN"},
-  {"Peabody","PPT","PPT"},
-  {"Peake","PK","PK"},
-  {"Pearson","PRSN","PRSN"},
-  {"Peat","PT","PT"},
-  {"Pedersen","PTRSN","PTRSN"},
-  {"Percy","PRS","PRS"},
-  {"Perkins","PRKNS","PRKNS"},
-  {"Perrine","PRN","PRN"},
-  {"Perry","PR","PR"},
-  {"Peson","PSN","PSN"},
-  {"Peterson","PTRSN","PTRSN"},
-  {"Peyton","PTN","PTN"},
-  {"Phinney","FN","FN"},
-  {"Pickard","PKRT","PKRT"},
-  {"Pierce","PRS","PRS"},
-  {"Pierrepont","PRPNT","PRPNT"},
-  {"Pike","PK","PK"},
-  {"Pinkham","PNKM","PNKM"},
-  {"Pitman","PTMN","PTMN"},
-  {"Pitt","PT","PT"},
-  {"Pitts","PTS","PTS"},
-  {"Plantagenet","PLNTJNT","PLNTKNT"},
-  {"Platt","PLT","PLT"},
-  {"Platts","PLTS","PLTS"},
-  {"Pleis","PLS","PLS"},
-  {"Pleiss","PLS","PLS"},
-  {"Plisko","PLSK","PLSK"},
-  {"Pliskovitch","PLSKFX","PLSKFX"},
-  {"Plum","PLM","PLM"},
-  {"Plume","PLM","PLM"},
-  {"Poitou","PT","PT"},
-  {"Pomeroy","PMR","PMR"},
-  {"Poretiers","PRTRS","PRTRS"},
-  {"Pote","PT","PT"},
-  {"Potter","PTR","PTR"},
-  {"Potts","PTS","PTS"},
-  {"Powell","PL","PL"},
-  {"Pratt","PRT","PRT"},
-  {"Presbury","PRSPR","PRSPR"},
-  {"Priest","PRST","PRST"},
-  {"Prindle","PRNTL","PRNTL"},
-  {"Prior","PRR","PRR"},
-  {"Profumo","PRFM","PRFM"},
-  {"Purdy","PRT","PRT"},
-  {"Purefoy","PRF","PRF"},
-  {"Pury","PR","PR"},
-  {"Quinter","KNTR","KNTR"},
-  {"Rachel","RXL","RKL"},
-  {"Rand","RNT","RNT"},
-  {"Rankin","RNKN","RNKN"},
-  {"Ravenscroft","RFNSKFT","RFNSKFT"},
-  {"Raynsford","RNSFRT","RNSFRT"},
-  {"Reakirt","RKRT","RKRT"},
-  {"Reaves","RFS","RFS"},
-  {"Reeves","RFS","RFS"},
-  {"Reichert","RXRT","RKRT"},
-  {"Remmele","RML","RML"},
-  {"Reynolds","RNLTS","RNLTS"},
-  {"Rhodes","RTS","RTS"},
-  {"Richards","RXRTS","RKRTS"},
-  {"Richardson","RXRTSN","RKRTSN"},
-  {"Ring","RNK","RNK"},
-  {"Roberts","RPRTS","RPRTS"},
-  {"Robertson","RPRTSN","RPRTSN"},
-  {"Robson","RPSN","RPSN"},
-  {"Rodie","RT","RT"},
-  {"Rody","RT","RT"},
-  {"Rogers","RKRS","RJRS"},
-  {"Ross","RS","RS"},
-  {"Rosslevin","RSLFN","RSLFN"},
-  {"Rowland","RLNT","RLNT"},
-  {"Ruehl","RL","RL"},
-  {"Russell","RSL","RSL"},
-  {"Ruth","R0","RT"},
-  {"Ryan","RN","RN"},
-  {"Rysse","RS","RS"},
-  {"Sadler","STLR","STLR"},
-  {"Salmon","SLMN","SLMN"},
-  {"Salter","SLTR","SLTR"},
-  {"Salvatore","SLFTR","SLFTR"},
-  {"Sanders","SNTRS","SNTRS"},
-  {"Sands","SNTS","SNTS"},
-  {"Sanford","SNFRT","SNFRT"},
-  {"Sanger","SNKR","SNJR"},
-  {"Sargent","SRJNT","SRKNT"},
-  {"Saunders","SNTRS","SNTRS"},
-  {"Schilling","XLNK","XLNK"},
-  {"Schlegel","XLKL","SLKL"},
-  {"Scott","SKT","SKT"},
-  {"Sears","SRS","SRS"},
-  {"Segersall","SJRSL","SKRSL"},
-  {"Senecal","SNKL","SNKL"},
-  {"Sergeaux","SRJ","SRK"},
-  {"Severance","SFRNS","SFRNS"},
-  {"Sharp","XRP","XRP"},
-  {"Sharpe","XRP","XRP"},
-  {"Sharply","XRPL","XRPL"},
-  {"Shatswell","XTSL","XTSL"},
-  {"Shattack","XTK","XTK"},
-  {"Shattock","XTK","XTK"},
-  {"Shattuck","XTK","XTK"},
-  {"Shaw","X","XF"},
-  {"Sheldon","XLTN","XLTN"},
-  {"Sherman","XRMN","XRMN"},
-  {"Shinn","XN","XN"},
-  {"Shirford","XRFRT","XRFRT"},
-  {"Shirley","XRL","XRL"},
-  {"Shively","XFL","XFL"},
-  {"Shoemaker","XMKR","XMKR"},
-  {"Short","XRT","XRT"},
-  {"Shotwell","XTL","XTL"},
-  {"Shute","XT","XT"},
-  {"Sibley","SPL","SPL"},
-  {"Silver","SLFR","SLFR"},
-  {"Simes","SMS","SMS"},
-  {"Sinken","SNKN","SNKN"},
-  {"Sinn","SN","SN"},
-  {"Skelton","SKLTN","SKLTN"},
-  {"Skiffe","SKF","SKF"},
-  {"Skotkonung","SKTKNNK","SKTKNNK"},
-  {"Slade","SLT","XLT"},
-  {"Slye","SL","XL"},
-  {"Smedley","SMTL","XMTL"},
-  {"Smith","SM0","XMT"},
-  {"Snow","SN","XNF"},
-  {"Soole","SL","SL"},
-  {"Soule","SL","SL"},
-  {"Southworth","S0R0","STRT"},
-  {"Sowles","SLS","SLS"},
-  {"Spalding","SPLTNK","SPLTNK"},
-  {"Spark","SPRK","SPRK"},
-  {"Spencer","SPNSR","SPNSR"},
-  {"Sperry","SPR","SPR"},
-  {"Spofford","SPFRT","SPFRT"},
-  {"Spooner","SPNR","SPNR"},
-  {"Sprague","SPRK","SPRK"},
-  {"Springer","SPRNKR","SPRNJR"},
-  {"St. Clair","STKLR","STKLR"},
-  {"St. Claire","STKLR","STKLR"},
-  {"St. Leger","STLJR","STLKR"},
-  {"St. Omer","STMR","STMR"},
-  {"Stafferton","STFRTN","STFRTN"},
-  {"Stafford","STFRT","STFRT"},
-  {"Stalham","STLM","STLM"},
-  {"Stanford","STNFRT","STNFRT"},
-  {"Stanton","STNTN","STNTN"},
-  {"Star","STR","STR"},
-  {"Starbuck","STRPK","STRPK"},
-  {"Starkey","STRK","STRK"},
-  {"Starkweather","STRK0R","STRKTR"},
-  {"Stearns","STRNS","STRNS"},
-  {"Stebbins","STPNS","STPNS"},
-  {"Steele","STL","STL"},
-  {"Stephenson","STFNSN","STFNSN"},
-  {"Stevens","STFNS","STFNS"},
-  {"Stoddard","STTRT","STTRT"},
-  {"Stodder","STTR","STTR"},
-  {"Stone","STN","STN"},
-  {"Storey","STR","STR"},
-  {"Storrada","STRT","STRT"},
-  {"Story","STR","STR"},
-  {"Stoughton","STFTN","STFTN"},
-  {"Stout","STT","STT"},
-  {"Stow","ST","STF"},
-  {"Strong","STRNK","STRNK"},
-  {"Strutt","STRT","STRT"},
-  {"Stryker","STRKR","STRKR"},
-  {"Stuckeley","STKL","STKL"},
-  {"Sturges","STRJS","STRKS"},
-  {"Sturgess","STRJS","STRKS"},
-  {"Sturgis","STRJS","STRKS"},
-  {"Suevain","SFN","SFN"},
-  {"Sulyard","SLRT","SLRT"},
-  {"Sutton","STN","STN"},
-  {"Swain","SN","XN"},
-  {"Swayne","SN","XN"},
-  {"Swayze","SS","XTS"},
-  {"Swift","SFT","XFT"},
-  {"Taber","TPR","TPR"},
-  {"Talcott","TLKT","TLKT"},
-  {"Tarne","TRN","TRN"},
-  {"Tatum","TTM","TTM"},
-  {"Taverner","TFRNR","TFRNR"},
-  {"Taylor","TLR","TLR"},
-  {"Tenney","TN","TN"},
-  {"Thayer","0R","TR"},
-  {"Thember","0MPR","TMPR"},
-  {"Thomas","TMS","TMS"},
-  {"Thompson","TMPSN","TMPSN"},
-  {"Thorne","0RN","TRN"},
-  {"Thornycraft","0RNKRFT","TRNKRFT"},
-  {"Threlkeld","0RLKLT","TRLKLT"},
-  {"Throckmorton","0RKMRTN","TRKMRTN"},
-  {"Thwaits","0TS","TTS"},
-  {"Tibbetts","TPTS","TPTS"},
-  {"Tidd","TT","TT"},
-  {"Tierney","TRN","TRN"},
-  {"Tilley","TL","TL"},
-  {"Tillieres","TLRS","TLRS"},
-  {"Tilly","TL","TL"},
-  {"Tisdale","TSTL","TSTL"},
-  {"Titus","TTS","TTS"},
-  {"Tobey","TP","TP"},
-  {"Tooker","TKR","TKR"},
-  {"Towle","TL","TL"},
-  {"Towne","TN","TN"},
-  {"Townsend","TNSNT","TNSNT"},
-  {"Treadway","TRT","TRT"},
-  {"Trelawney","TRLN","TRLN"},
-  {"Trinder","TRNTR","TRNTR"},
-  {"Tripp","TRP","TRP"},
-  {"Trippe","TRP","TRP"},
-  {"Trott","TRT","TRT"},
-  {"True","TR","TR"},
-  {"Trussebut","TRSPT","TRSPT"},
-  {"Tucker","TKR","TKR"},
-  {"Turgeon","TRJN","TRKN"},
-  {"Turner","TRNR","TRNR"},
-  {"Tuttle","TTL","TTL"},
-  {"Tyler","TLR","TLR"},
-  {"Tylle","TL","TL"},
-  {"Tyrrel","TRL","TRL"},
-  {"Ua Tuathail","AT0L","ATTL"},
-  {"Ulrich","ALRX","ALRK"},
-  {"Underhill","ANTRL","ANTRL"},
-  {"Underwood","ANTRT","ANTRT"},
-  {"Unknown","ANKNN","ANKNN"},
-  {"Valentine","FLNTN","FLNTN"},
-  {"Van Egmond","FNKMNT","FNKMNT"},
-  {"Van der Beek","FNTRPK","FNTRPK"},
-  {"Vaughan","FKN","FKN"},
-  {"Vermenlen","FRMNLN","FRMNLN"},
-  {"Vincent","FNSNT","FNSNT"},
-  {"Volentine","FLNTN","FLNTN"},
-  {"Wagner","AKNR","FKNR"},
-  {"Waite","AT","FT"},
-  {"Walker","ALKR","FLKR"},
-  {"Walter","ALTR","FLTR"},
-  {"Wandell","ANTL","FNTL"},
-  {"Wandesford","ANTSFRT","FNTSFRT"},
-  {"Warbleton","ARPLTN","FRPLTN"},
-  {"Ward","ART","FRT"},
-  {"Warde","ART","FRT"},
-  {"Ware","AR","FR"},
-  {"Wareham","ARHM","FRHM"},
-  {"Warner","ARNR","FRNR"},
-  {"Warren","ARN","FRN"},
-  {"Washburne","AXPRN","FXPRN"},
-  {"Waterbury","ATRPR","FTRPR"},
-  {"Watson","ATSN","FTSN"},
-  {"WatsonEllithorpe","ATSNL0RP","FTSNLTRP"},
-  {"Watts","ATS","FTS"},
-  {"Wayne","AN","FN"},
-  {"Webb","AP","FP"},
-  {"Weber","APR","FPR"},
-  {"Webster","APSTR","FPSTR"},
-  {"Weed","AT","FT"},
-  {"Weeks","AKS","FKS"},
-  {"Wells","ALS","FLS"},
-  {"Wenzell","ANSL","FNTSL"},
-  {"West","AST","FST"},
-  {"Westbury","ASTPR","FSTPR"},
-  {"Whatlocke","ATLK","ATLK"},
-  {"Wheeler","ALR","ALR"},
-  {"Whiston","ASTN","ASTN"},
-  {"White","AT","AT"},
-  {"Whitman","ATMN","ATMN"},
-  {"Whiton","ATN","ATN"},
-  {"Whitson","ATSN","ATSN"},
-  {"Wickes","AKS","FKS"},
-  {"Wilbur","ALPR","FLPR"},
-  {"Wilcotes","ALKTS","FLKTS"},
-  {"Wilkinson","ALKNSN","FLKNSN"},
-  {"Willets","ALTS","FLTS"},
-  {"Willett","ALT","FLT"},
-  {"Willey","AL","FL"},
-  {"Williams","ALMS","FLMS"},
-  {"Williston","ALSTN","FLSTN"},
-  {"Wilson","ALSN","FLSN"},
-  {"Wimes","AMS","FMS"},
-  {"Winch","ANX","FNK"},
-  {"Winegar","ANKR","FNKR"},
-  {"Wing","ANK","FNK"},
-  {"Winsley","ANSL","FNSL"},
-  {"Winslow","ANSL","FNSLF"},
-  {"Winthrop","AN0RP","FNTRP"},
-  {"Wise","AS","FS"},
-  {"Wood","AT","FT"},
-  {"Woodbridge","ATPRJ","FTPRJ"},
-  {"Woodward","ATRT","FTRT"},
-  {"Wooley","AL","FL"},
-  {"Woolley","AL","FL"},
-  {"Worth","AR0","FRT"},
-  {"Worthen","AR0N","FRTN"},
-  {"Worthley","AR0L","FRTL"},
-  {"Wright","RT","RT"},
-  {"Wyer","AR","FR"},
-  {"Wyere","AR","FR"},
-  {"Wynkoop","ANKP","FNKP"},
-  {"Yarnall","ARNL","ARNL"},
-  {"Yeoman","AMN","AMN"},
-  {"Yorke","ARK","ARK"},
-  {"Young","ANK","ANK"},
-  {"ab Wennonwen","APNNN","APNNN"},
-  {"ap Llewellyn","APLLN","APLLN"},
-  {"ap Lorwerth","APLRR0","APLRRT"},
-  {"d'Angouleme","TNKLM","TNKLM"},
-  {"de Audeham","TTHM","TTHM"},
-  {"de Bavant","TPFNT","TPFNT"},
-  {"de Beauchamp","TPXMP","TPKMP"},
-  {"de Beaumont","TPMNT","TPMNT"},
-  {"de Bolbec","TPLPK","TPLPK"},
-  {"de Braiose","TPRS","TPRS"},
-  {"de Braose","TPRS","TPRS"},
-  {"de Briwere","TPRR","TPRR"},
-  {"de Cantelou","TKNTL","TKNTL"},
-  {"de Cherelton","TXRLTN","TKRLTN"},
-  {"de Cherleton","TXRLTN","TKRLTN"},
-  {"de Clare","TKLR","TKLR"},
-  {"de Claremont","TKLRMNT","TKLRMNT"},
-  {"de Clifford","TKLFRT","TKLFRT"},
-  {"de Colville","TKLFL","TKLFL"},
-  {"de Courtenay","TKRTN","TKRTN"},
-  {"de Fauconberg","TFKNPRK","TFKNPRK"},
-  {"de Forest","TFRST","TFRST"},
-  {"de Gai","TK","TK"},
-  {"de Grey","TKR","TKR"},
-  {"de Guernons","TKRNNS","TKRNNS"},
-  {"de Haia","T","T"},
-  {"de Harcourt","TRKRT","TRKRT"},
-  {"de Hastings","TSTNKS","TSTNKS"},
-  {"de Hoke","TK","TK"},
-  {"de Hooch","TX","TK"},
-  {"de Hugelville","TJLFL","TKLFL"},
-  {"de Huntingdon","TNTNKTN","TNTNKTN"},
-  {"de Insula","TNSL","TNSL"},
-  {"de Keynes","TKNS","TKNS"},
-  {"de Lacy","TLS","TLS"},
-  {"de Lexington","TLKSNKTN","TLKSNKTN"},
-  {"de Lusignan","TLSNN","TLSKNN"},
-  {"de Manvers","TMNFRS","TMNFRS"},
-  {"de Montagu","TMNTK","TMNTK"},
-  {"de Montault","TMNTLT","TMNTLT"},
-  {"de Montfort","TMNTFRT","TMNTFRT"},
-  {"de Mortimer","TMRTMR","TMRTMR"},
-  {"de Morville","TMRFL","TMRFL"},
-  {"de Morvois","TMRF","TMRFS"},
-  {"de Neufmarche","TNFMRX","TNFMRK"},
-  {"de Odingsells","TTNKSLS","TTNKSLS"},
-  {"de Odyngsells","TTNKSLS","TTNKSLS"},
-  {"de Percy","TPRS","TPRS"},
-  {"de Pierrepont","TPRPNT","TPRPNT"},
-  {"de Plessetis","TPLSTS","TPLSTS"},
-  {"de Porhoet","TPRT","TPRT"},
-  {"de Prouz","TPRS","TPRS"},
-  {"de Quincy","TKNS","TKNS"},
-  {"de Ripellis","TRPLS","TRPLS"},
-  {"de Ros","TRS","TRS"},
-  {"de Salisbury","TSLSPR","TSLSPR"},
-  {"de Sanford","TSNFRT","TSNFRT"},
-  {"de Somery","TSMR","TSMR"},
-  {"de St. Hilary","TSTLR","TSTLR"},
-  {"de St. Liz","TSTLS","TSTLS"},
-  {"de Sutton","TSTN","TSTN"},
-  {"de Toeni","TTN","TTN"},
-  {"de Tony","TTN","TTN"},
-  {"de Umfreville","TMFRFL","TMFRFL"},
-  {"de Valognes","TFLNS","TFLKNS"},
-  {"de Vaux","TF","TF"},
-  {"de Vere","TFR","TFR"},
-  {"de Vermandois","TFRMNT","TFRMNTS"},
-  {"de Vernon","TFRNN","TFRNN"},
-  {"de Vexin","TFKSN","TFKSN"},
-  {"de Vitre","TFTR","TFTR"},
-  {"de Wandesford","TNTSFRT","TNTSFRT"},
-  {"de Warenne","TRN","TRN"},
-  {"de Westbury","TSTPR","TSTPR"},
-  {"di Saluzzo","TSLS","TSLTS"},
-  {"fitz Alan","FTSLN","FTSLN"},
-  {"fitz Geoffrey","FTSJFR","FTSKFR"},
-  {"fitz Herbert","FTSRPRT","FTSRPRT"},
-  {"fitz John","FTSJN","FTSJN"},
-  {"fitz Patrick","FTSPTRK","FTSPTRK"},
-  {"fitz Payn","FTSPN","FTSPN"},
-  {"fitz Piers","FTSPRS","FTSPRS"},
-  {"fitz Randolph","FTSRNTLF","FTSRNTLF"},
-  {"fitz Richard","FTSRXRT","FTSRKRT"},
-  {"fitz Robert","FTSRPRT","FTSRPRT"},
-  {"fitz Roy","FTSR","FTSR"},
-  {"fitz Scrob","FTSSKP","FTSSKP"},
-  {"fitz Walter","FTSLTR","FTSLTR"},
-  {"fitz Warin","FTSRN","FTSRN"},
-  {"fitz Williams","FTSLMS","FTSLMS"},
-  {"la Zouche","LSX","LSK"},
-  {"le Botiller","LPTLR","LPTLR"},
-  {"le Despenser","LTSPNSR","LTSPNSR"},
-  {"le deSpencer","LTSPNSR","LTSPNSR"},
-  {"of Allendale","AFLNTL","AFLNTL"},
-  {"of Angouleme","AFNKLM","AFNKLM"},
-  {"of Anjou","AFNJ","AFNJ"},
-  {"of Aquitaine","AFKTN","AFKTN"},
-  {"of Aumale","AFML","AFML"},
-  {"of Bavaria","AFPFR","AFPFR"},
-  {"of Boulogne","AFPLN","AFPLKN"},
-  {"of Brittany","AFPRTN","AFPRTN"},
-  {"of Brittary","AFPRTR","AFPRTR"},
-  {"of Castile","AFKSTL","AFKSTL"},
-  {"of Chester","AFXSTR","AFKSTR"},
-  {"of Clermont","AFKLRMNT","AFKLRMNT"},
-  {"of Cologne","AFKLN","AFKLKN"},
-  {"of Dinan","AFTNN","AFTNN"},
-  {"of Dunbar","AFTNPR","AFTNPR"},
-  {"of England","AFNKLNT","AFNKLNT"},
-  {"of Essex","AFSKS","AFSKS"},
-  {"of Falaise","AFFLS","AFFLS"},
-  {"of Flanders","AFFLNTRS","AFFLNTRS"},
-  {"of Galloway","AFKL","AFKL"},
-  {"of Germany","AFKRMN","AFJRMN"},
-  {"of Gloucester","AFKLSSTR","AFKLSSTR"},
-  {"of Heristal","AFRSTL","AFRSTL"},
-  {"of Hungary","AFNKR","AFNKR"},
-  {"of Huntington","AFNTNKTN","AFNTNKTN"},
-  {"of Kiev","AFKF","AFKF"},
-  {"of Kuno","AFKN","AFKN"},
-  {"of Landen","AFLNTN","AFLNTN"},
-  {"of Laon","AFLN","AFLN"},
-  {"of Leinster","AFLNSTR","AFLNSTR"},
-  {"of Lens","AFLNS","AFLNS"},
-  {"of Lorraine","AFLRN","AFLRN"},
-  {"of Louvain","AFLFN","AFLFN"},
-  {"of Mercia","AFMRS","AFMRX"},
-  {"of Metz","AFMTS","AFMTS"},
-  {"of Meulan","AFMLN","AFMLN"},
-  {"of Nass","AFNS","AFNS"},
-  {"of Normandy","AFNRMNT","AFNRMNT"},
-  {"of Ohningen","AFNNJN","AFNNKN"},
-  {"of Orleans","AFRLNS","AFRLNS"},
-  {"of Poitou","AFPT","AFPT"},
-  {"of Polotzk","AFPLTSK","AFPLTSK"},
-  {"of Provence","AFPRFNS","AFPRFNS"},
-  {"of Ringelheim","AFRNJLM","AFRNKLM"},
-  {"of Salisbury","AFSLSPR","AFSLSPR"},
-  {"of Saxony","AFSKSN","AFSKSN"},
-  {"of Scotland","AFSKTLNT","AFSKTLNT"},
-  {"of Senlis","AFSNLS","AFSNLS"},
-  {"of Stafford","AFSTFRT","AFSTFRT"},
-  {"of Swabia","AFSP","AFSP"},
-  {"of Tongres","AFTNKRS","AFTNKRS"},
-  {"of the Tributes","AF0TRPTS","AFTTRPTS"},
-  {"unknown","ANKNN","ANKNN"},
-  {"van der Gouda","FNTRKT","FNTRKT"},
-  {"von Adenbaugh","FNTNP","FNTNP"},
-  {"ARCHITure","ARKTR","ARKTR"},
-  {"Arnoff","ARNF","ARNF"},
-  {"Arnow","ARN","ARNF"},
-  {"DANGER","TNJR","TNKR"},
-  {"Jankelowicz","JNKLTS","ANKLFX"},
-  {"MANGER","MNJR","MNKR"},
-  {"McClellan","MKLLN","MKLLN"},
-  {"McHugh","MK","MK"},
-  {"McLaughlin","MKLFLN","MKLFLN"},
-  {"ORCHEStra","ARKSTR","ARKSTR"},
-  {"ORCHID","ARKT","ARKT"},
-  {"Pierce","PRS","PRS"},
-  {"RANGER","RNJR","RNKR"},
-  {"Schlesinger","XLSNKR","SLSNJR"},
-  {"Uomo","AM","AM"},
-  {"Vasserman","FSRMN","FSRMN"},
-  {"Wasserman","ASRMN","FSRMN"},
-  {"Womo","AM","FM"},
-  {"Yankelovich","ANKLFX","ANKLFK"},
-  {"accede","AKST","AKST"},
-  {"accident","AKSTNT","AKSTNT"},
-  {"adelsheim","ATLSM","ATLSM"},
-  {"aged","AJT","AKT"},
-  {"ageless","AJLS","AKLS"},
-  {"agency","AJNS","AKNS"},
-  {"aghast","AKST","AKST"},
-  {"agio","AJ","AK"},
-  {"agrimony","AKRMN","AKRMN"},
-  {"album","ALPM","ALPM"},
-  {"alcmene","ALKMN","ALKMN"},
-  {"alehouse","ALHS","ALHS"},
-  {"antique","ANTK","ANTK"},
-  {"artois","ART","ARTS"},
-  {"automation","ATMXN","ATMXN"},
-  {"bacchus","PKS","PKS"},
-  {"bacci","PX","PX"},
-  {"bajador","PJTR","PHTR"},
-  {"bellocchio","PLX","PLX"},
-  {"bertucci","PRTX","PRTX"},
-  {"biaggi","PJ","PK"},
-  {"bough","P","P"},
-  {"breaux","PR","PR"},
-  {"broughton","PRTN","PRTN"},
-  {"cabrillo","KPRL","KPR"},
-  {"caesar","SSR","SSR"},
-  {"cagney","KKN","KKN"},
-  {"campbell","KMPL","KMPL"},
-  {"carlisle","KRLL","KRLL"},
-  {"carlysle","KRLL","KRLL"},
-  {"chemistry","KMSTR","KMSTR"},
-  {"chianti","KNT","KNT"},
-  {"chorus","KRS","KRS"},
-  {"cough","KF","KF"},
-  {"czerny","SRN","XRN"},
-  {"deffenbacher","TFNPKR","TFNPKR"},
-  {"dumb","TM","TM"},
-  {"edgar","ATKR","ATKR"},
-  {"edge","AJ","AJ"},
-  {"filipowicz","FLPTS","FLPFX"},
-  {"focaccia","FKX","FKX"},
-  {"gallegos","KLKS","KKS"},
-  {"gambrelli","KMPRL","KMPRL"},
-  {"geithain","K0N","JTN"},
-  {"ghiradelli","JRTL","JRTL"},
-  {"ghislane","JLN","JLN"},
-  {"gough","KF","KF"},
-  {"hartheim","HR0M","HRTM"},
-  {"heimsheim","HMSM","HMSM"},
-  {"hochmeier","HKMR","HKMR"},
-  {"hugh","H","H"},
-  {"hunger","HNKR","HNJR"},
-  {"hungry","HNKR","HNKR"},
-  {"island","ALNT","ALNT"},
-  {"isle","AL","AL"},
-  {"jose","HS","HS"},
-  {"laugh","LF","LF"},
-  {"mac caffrey","MKFR","MKFR"},
-  {"mac gregor","MKRKR","MKRKR"},
-  {"pegnitz","PNTS","PKNTS"},
-  {"piskowitz","PSKTS","PSKFX"},
-  {"queen","KN","KN"},
-  {"raspberry","RSPR","RSPR"},
-  {"resnais","RSN","RSNS"},
-  {"rogier","RJ","RJR"},
-  {"rough","RF","RF"},
-  {"san jacinto","SNHSNT","SNHSNT"},
-  {"schenker","XNKR","SKNKR"},
-  {"schermerhorn","XRMRRN","SKRMRRN"},
-  {"schmidt","XMT","SMT"},
-  {"schneider","XNTR","SNTR"},
-  {"school","SKL","SKL"},
-  {"schooner","SKNR","SKNR"},
-  {"schrozberg","XRSPRK","SRSPRK"},
-  {"schulman","XLMN","XLMN"},
-  {"schwabach","XPK","XFPK"},
-  {"schwarzach","XRSK","XFRTSK"},
-  {"smith","SM0","XMT"},
-  {"snider","SNTR","XNTR"},
-  {"succeed","SKST","SKST"},
-  {"sugarcane","XKRKN","SKRKN"},
-  {"svobodka","SFPTK","SFPTK"},
-  {"tagliaro","TKLR","TLR"},
-  {"thames","TMS","TMS"},
-  {"theilheim","0LM","TLM"},
-  {"thomas","TMS","TMS"},
-  {"thumb","0M","TM"},
-  {"tichner","TXNR","TKNR"},
-  {"tough","TF","TF"},
-  {"umbrella","AMPRL","AMPRL"},
-  {"vilshofen","FLXFN","FLXFN"},
-  {"von schuller","FNXLR","FNXLR"},
-  {"wachtler","AKTLR","FKTLR"},
-  {"wechsler","AKSLR","FKSLR"},
-  {"weikersheim","AKRSM","FKRSM"},
-  {"zhao","J","J"},
-  {u8"Çelik", "SLK", "SLK"},
-  {u8"Curaçao", "KRS", "KRS"},
-  {u8"Iñaki", "ANK", "ANK"},
-  {u8"Iruña", "ARN", "ARN"}
-};
+  const std::size_t count = sizeof(tests) / sizeof(tests[0]);
+  std::vector<dm::packed_keys> keys;
+  for (auto& test : tests)
+    keys.push_back(dm::packed_keys(dm::pack_key(test[1]), dm::pack_key(test[2])));
+
+  // start from half the tests, then churn through inserts and erases while readers look up
+  dm::index_builder builder;
+  std::vector<bool> present(count);
+  for (std::size_t i = 0; i < count; i += 2)
+  {
+    builder.add(dm::record_id(i), keys[i]);
+    present[i] = true;
+  }
+  dm::live_index live(builder.build(), 64);
+
+  std::atomic<bool> done(false);
+  std::atomic<int> misordered(0);
+  std::vector<std::thread> readers;
+  for (int thread = 0; thread < 4; ++thread)
+    readers.push_back(std::thread([&]
+                                  {
+                                    dm::live_index::reader reader(live);
+                                    std::vector<dm::record_id> ids;
+                                    for (std::size_t i = 0; !done; i = (i + 1) % count)
+                                    {
+                                      ids.clear();
+                                      reader.lookup(keys[i], ids);
+                                      if (!std::is_sorted(ids.begin(), ids.end()) || std::adjacent_find(ids.begin(), ids.end()) != ids.end())
+                                        ++misordered;
+                                    }
+                                  }));
+
+  for (int round = 0; round < 3; ++round)
+    for (std::size_t i = round; i < count; i += 3)
+    {
+      if (present[i])
+        live.erase(dm::record_id(i), keys[i]);
+      else
+        live.insert(dm::record_id(i), keys[i]);
+      present[i] = !present[i];
+    }
+  live.compact();
+  for (std::size_t i = 1; i < count; i += 5)
+  {
+    if (present[i])
+      live.erase(dm::record_id(i), keys[i]);
+    else
+      live.insert(dm::record_id(i), keys[i]);
+    present[i] = !present[i];
+  }
+  done = true;
+  for (auto& reader : readers)
+    reader.join();
+
+  int mismatches = misordered;
+  dm::live_index::reader reader(live);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    std::vector<dm::record_id> ids;
+    reader.lookup(keys[i], ids);
+    std::vector<dm::record_id> expected;
+    for (std::size_t j = 0; j < count; ++j)
+      if (present[j] && (keys[j].first == keys[i].first || keys[j].first == keys[i].second
+                         || keys[j].second == keys[i].first || keys[j].second == keys[i].second))
+        expected.push_back(dm::record_id(j));
+    if (ids != expected)
+    {
+      std::clog << "Mismatched live index " << tests[i][0] << "\n";
+      ++mismatches;
+    }
+  }
+
+  // many single writes toggling a few keys of a few ids, through chunks of the delta merging down, then compacted
+  dm::index_builder seeded;
+  std::vector<std::vector<bool>> model(8, std::vector<bool>(64));
+  for (dm::record_id id = 0; id < 64; id += 3)
+  {
+    seeded.add(id, dm::packed_keys(id % 8 + 1, id % 8 + 1));
+    model[id % 8][id] = true;
+  }
+  dm::live_index churned(seeded.build(), std::size_t(1) << 30);
+  std::uint32_t seed = 7;
+  for (int write = 0; write < 20000; ++write)
+  {
+    seed = seed * 1664525 + 1013904223;
+    const dm::packed_key key = (seed >> 8) % 8;
+    const dm::record_id id = (seed >> 16) % 64;
+    if (model[key][id])
+      churned.erase(id, dm::packed_keys(key + 1, key + 1));
+    else
+      churned.insert(id, dm::packed_keys(key + 1, key + 1));
+    model[key][id] = !model[key][id];
+  }
+  for (int compacted = 0; compacted < 2; ++compacted)
+  {
+    if (compacted)
+      churned.compact();
+    dm::live_index::reader churned_reader(churned);
+    for (dm::packed_key key = 0; key < 8; ++key)
+    {
+      std::vector<dm::record_id> ids;
+      churned_reader.lookup(key + 1, ids);
+      std::vector<dm::record_id> expected;
+      for (dm::record_id id = 0; id < 64; ++id)
+        if (model[key][id])
+          expected.push_back(id);
+      if (ids != expected)
+      {
+        std::clog << "Mismatched churned live index key " << key + 1 << (compacted ? " compacted\n" : "\n");
+        ++mismatches;
+      }
+    }
+  }
+  if (churned.delta_size() != 0)
+  {
+    std::clog << "Mismatched live index delta of " << churned.delta_size() << " after compacting\n";
+    ++mismatches;
+  }
+  return mismatches;
+}
+
+int test_postings()
+{
+  int mismatches = 0;
+
+  // lists of various lengths and overlaps, with gaps needing 1 to 4 bytes
+  std::uint32_t seed = 1;
+  auto random = [&seed]() { return seed = seed * 1664525 + 1013904223; };
+  for (int round = 0; round < 200; ++round)
+  {
+    std::vector<dm::record_id> a;
+    std::vector<dm::record_id> b;
+    const std::uint32_t spread = 1u << (round % 28);
+    for (std::size_t i = 0, count = random() % 100; i < count; ++i)
+      a.push_back(random() % (spread + 50));
+    for (std::size_t i = 0, count = random() % 100; i < count; ++i)
+      b.push_back(random() % (spread + 50));
+    std::sort(a.begin(), a.end());
+    a.erase(std::unique(a.begin(), a.end()), a.end());
+    std::sort(b.begin(), b.end());
+    b.erase(std::unique(b.begin(), b.end()), b.end());
+
+    std::vector<dm::record_id> expected_intersection;
+    std::vector<dm::record_id> expected_union;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected_intersection));
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected_union));
+    for (bool simd : {false, true})
+    {
+      std::vector<dm::record_id> intersection;
+      std::vector<dm::record_id> united;
+      dm::intersect_ids(a.data(), a.size(), b.data(), b.size(), intersection, simd);
+      dm::unite_ids(a.data(), a.size(), b.data(), b.size(), united, simd);
+      if (intersection != expected_intersection || united != expected_union)
+      {
+        std::clog << "Mismatched postings set operations in round " << round << (simd ? " with simd\n" : "\n");
+        ++mismatches;
+      }
+    }
+  }
+
+  // long postings of a few keys as well as the short postings of the tests
+  std::vector<dm::index::entry> entries;
+  for (std::uint32_t id = 0; id < 100000; id += 1 + random() % (1u << (id % 20)))
+    entries.push_back(dm::index::entry(dm::pack_key(tests[id % 7][1]), id));
+  for (auto index : {make_test_index(), dm::index(entries)})
+  {
+    dm::compressed_index compressed(index.view());
+    for (std::size_t position = 0; position < index.size(); ++position)
+      for (bool simd : {false, true})
+      {
+        std::vector<dm::record_id> decoded;
+        compressed.decode(position, decoded, simd);
+        auto ids = index.postings(position);
+        if (decoded.size() != ids.size() || !std::equal(decoded.begin(), decoded.end(), ids.begin()))
+        {
+          std::clog << "Mismatched compressed postings of " << dm::unpack_key(index.keys()[position]) << "\n";
+          ++mismatches;
+        }
+      }
+  }
+  return mismatches;
+}
+
+int test_dictionary()
+{
+  int mismatches = 0;
+
+  // the keys of the tests and a dense run of random keys sharing long prefixes
+  std::uint32_t seed = 1;
+  auto random = [&seed]() { return seed = seed * 1664525 + 1013904223; };
+  std::vector<dm::packed_key> random_keys;
+  for (int i = 0; i < 20000; ++i)
+  {
+    dm::packed_key key = 0;
+    for (std::size_t len = 1 + random() % 16, symbol = 0; symbol < len; ++symbol)
+      key |= dm::packed_key(1 + (random() >> 8) % (symbol < 3 ? 3 : 14)) << (60 - 4 * symbol);
+    random_keys.push_back(key);
+  }
+  std::sort(random_keys.begin(), random_keys.end());
+  random_keys.erase(std::unique(random_keys.begin(), random_keys.end()), random_keys.end());
+
+  char path[] = "/tmp/dm_dictionary_XXXXXX";
+  const int file = ::mkstemp(path);
+  if (file < 0)
+    return 1;
+  ::close(file);
+
+  const auto test_keys = make_test_index().keys();
+  for (auto keys : {std::vector<dm::packed_key>(), test_keys, random_keys})
+  {
+    dm::dictionary built(keys.data(), keys.size());
+    dm::write_dictionary(built.view(), path);
+    dm::mapped_dictionary mapped(path);
+    for (auto dictionary : {built.view(), mapped.view()})
+    {
+      if (dictionary.size() != keys.size() || !std::equal(dictionary.begin(), dictionary.end(), keys.begin()))
+      {
+        std::clog << "Mismatched dictionary keys\n";
+        ++mismatches;
+      }
+      for (std::size_t position = 0; position < keys.size(); ++position)
+        if (dictionary.select(position) != keys[position] || dictionary.find(keys[position]) != position)
+        {
+          std::clog << "Mismatched dictionary select " << dm::unpack_key(keys[position]) << "\n";
+          ++mismatches;
+        }
+
+      // every prefix of some keys, and keys between them
+      for (std::size_t i = 0; i < keys.size(); i += 7)
+        for (std::size_t len = 0; len <= dm::packed_length(keys[i]); ++len)
+        {
+          const auto prefix = keys[i] & dm::packed_prefix_mask(len);
+          const auto range = dictionary.prefix_range(prefix, len);
+          std::size_t first = keys.size();
+          std::size_t last = 0;
+          for (std::size_t position = 0; position < keys.size(); ++position)
+            if ((keys[position] & dm::packed_prefix_mask(len)) == prefix)
+            {
+              first = std::min(first, position);
+              last = position + 1;
+            }
+          const auto between = keys[i] - 1;
+          if (range.first != first || range.second != last
+              || dictionary.rank(between) != std::size_t(std::lower_bound(keys.begin(), keys.end(), between) - keys.begin())
+              || (!std::binary_search(keys.begin(), keys.end(), between) && dictionary.find(between) != keys.size()))
+          {
+            std::clog << "Mismatched dictionary prefix " << dm::unpack_key(prefix) << "\n";
+            ++mismatches;
+          }
+        }
+    }
+  }
+
+  // headers whose sizes overflow, and blocks starting past the bytes
+  dm::dictionary built(test_keys.data(), test_keys.size());
+  dm::write_dictionary(built.view(), path);
+  std::string written;
+  {
+    std::ifstream in(path, std::ios::binary);
+    written.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  dm::dictionary_file_header header;
+  std::memcpy(&header, written.data(), sizeof(header));
+  std::string huge = written;
+  header.keys = ~std::uint64_t(0);
+  std::memcpy(&huge[0], &header, sizeof(header));
+  std::string past = written;
+  const std::size_t blocks = (test_keys.size() + dm::dictionary_block_size - 1) / dm::dictionary_block_size;
+  const std::uint32_t start = std::uint32_t(written.size());
+  std::memcpy(&past[sizeof(header) + blocks * sizeof(dm::packed_key) + sizeof(start)], &start, sizeof(start));
+
+  // coded bytes running past the end, sharing more than the last key, blocks out of order or not using all their bytes
+  const std::size_t starts_at = sizeof(header) + blocks * sizeof(dm::packed_key);
+  const std::size_t bytes_at = starts_at + (blocks + 1) * sizeof(std::uint32_t);
+  std::string overrun = written;
+  const std::uint32_t last_start = std::uint32_t(header.bytes - 1);
+  std::memcpy(&overrun[starts_at + (blocks - 1) * sizeof(last_start)], &last_start, sizeof(last_start));
+  overrun.back() = 0x0F;
+  std::string overshared = written;
+  overshared[bytes_at] = char(0xF0 | (overshared[bytes_at] & 0x0F));
+  std::string unordered = written;
+  std::memcpy(&unordered[sizeof(header)], &written[sizeof(header) + sizeof(dm::packed_key)], sizeof(dm::packed_key));
+  std::memcpy(&unordered[sizeof(header) + sizeof(dm::packed_key)], &written[sizeof(header)], sizeof(dm::packed_key));
+  std::string unused = written;
+  std::uint32_t second_start;
+  std::memcpy(&second_start, &written[starts_at + sizeof(second_start)], sizeof(second_start));
+  ++second_start;
+  std::memcpy(&unused[starts_at + sizeof(second_start)], &second_start, sizeof(second_start));
+  for (auto corrupt : {written.substr(0, written.size() - 1), huge, past, overrun, overshared, unordered, unused})
+  {
+    {
+      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+      out.write(corrupt.data(), std::streamsize(corrupt.size()));
+    }
+    try
+    {
+      dm::mapped_dictionary mapped(path);
+      std::clog << "Mismatched corrupt dictionary of " << corrupt.size() << " bytes\n";
+      ++mismatches;
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+  }
+  std::remove(path);
+  return mismatches;
+}
+
+int test_prefix()
+{
+  auto index = make_test_index();
+  dm::dictionary dictionary(index.view());
+
+  int mismatches = 0;
+  for (std::size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i += 3)
+    for (std::size_t len = 0, length = std::strlen(tests[i][1]); len <= length; ++len)
+    {
+      const std::string prefix(tests[i][1], len);
+      std::vector<dm::record_id> expected;
+      for (std::size_t j = 0; j < sizeof(tests) / sizeof(tests[0]); ++j)
+        if (std::strncmp(tests[j][1], prefix.c_str(), len) == 0 || std::strncmp(tests[j][2], prefix.c_str(), len) == 0)
+          expected.push_back(dm::record_id(j));
+
+      // one at a time and in batches, with a heap of every key and of a few at a time
+      for (std::size_t max_cursors : {dm::merge_cursors, std::size_t(1), std::size_t(3)})
+      {
+        std::vector<dm::record_id> streamed;
+        for (auto postings = dm::prefix_postings(index.view(), prefix, max_cursors); postings.valid(); postings.advance())
+          streamed.push_back(postings.current());
+        std::vector<dm::record_id> read;
+        auto postings = dm::prefix_postings(index.view(), prefix, max_cursors);
+        dm::record_id batch[7];
+        while (std::size_t count = postings.read(batch, 7))
+          read.insert(read.end(), batch, batch + count);
+
+        if (streamed != expected || read != expected || index.prefix_range(dm::pack_key(prefix), len) != dictionary.prefix_range(dm::pack_key(prefix), len))
+        {
+          std::clog << "Mismatched prefix " << prefix << " merging " << max_cursors << " keys at a time\n";
+          ++mismatches;
+        }
+      }
+    }
+  return mismatches;
+}
+
+int test_composite()
+{
+  // pairs of test words as given name and surname
+  const std::size_t count = sizeof(tests) / sizeof(tests[0]);
+  dm::index_builder builder;
+  for (std::size_t i = 0; i < count; ++i)
+    for (auto key : dm::composite_keys(tests[i][0], tests[(i * 7) % count][0]))
+      builder.add(dm::record_id(i), key);
+  auto index = builder.build();
+
+  int mismatches = 0;
+  for (std::size_t i = 0; i < count; i += 3)
+  {
+    dm::composite_keys keys(dm::packed_keys(dm::pack_key(tests[i][1]), dm::pack_key(tests[i][2])),
+                            dm::packed_keys(dm::pack_key(tests[(i * 7) % count][2]), dm::pack_key(tests[(i * 7) % count][2])));
+    std::vector<dm::record_id> ids;
+    dm::composite_lookup(index.view(), keys, ids);
+
+    // the records whose given name shares a key and whose surname has the alternate key, up to the field capacity
+    std::vector<dm::record_id> expected;
+    const auto field = dm::packed_prefix_mask(dm::composite_field_capacity);
+    const auto surname = dm::pack_key(tests[(i * 7) % count][2]) & field;
+    for (std::size_t j = 0; j < count; ++j)
+    {
+      const auto given1 = dm::pack_key(tests[j][1]) & field;
+      const auto given2 = dm::pack_key(tests[j][2]) & field;
+      const auto surname1 = dm::pack_key(tests[(j * 7) % count][1]) & field;
+      const auto surname2 = dm::pack_key(tests[(j * 7) % count][2]) & field;
+      const bool given = given1 == (dm::pack_key(tests[i][1]) & field) || given1 == (dm::pack_key(tests[i][2]) & field)
+        || given2 == (dm::pack_key(tests[i][1]) & field) || given2 == (dm::pack_key(tests[i][2]) & field);
+      if (given && (surname1 == surname || surname2 == surname))
+        expected.push_back(dm::record_id(j));
+    }
+
+    if (ids != expected || !std::binary_search(ids.begin(), ids.end(), dm::record_id(i))
+        || dm::decompose_key(*keys.begin()) != std::make_pair(dm::pack_key(tests[i][1]) & field, surname))
+    {
+      std::clog << "Mismatched composite " << tests[i][0] << " " << tests[(i * 7) % count][0] << "\n";
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+int test_parts()
+{
+  // the tests, with empty words and a word longer than a batch among them
+  std::vector<std::string> words;
+  for (auto& test : tests)
+  {
+    words.push_back(test[0]);
+    if (words.size() % 50 == 0)
+      words.push_back("");
+  }
+  words.push_back(std::string(300, 'b') + "ARNES");
+
+  std::vector<std::vector<dm::key_part>> expected;
+  for (auto& word : words)
+  {
+    expected.push_back(std::vector<dm::key_part>());
+    dm::double_metaphone(word, [&expected](const char* metaph1, const char* metaph2, size_t start, size_t len)
+                         {
+                           dm::key_part part = { std::uint8_t(dm::pack_key(metaph1 ? metaph1 : "") >> 56), std::uint8_t(dm::pack_key(metaph2 ? metaph2 : "") >> 56), std::uint16_t(len), std::uint32_t(start) };
+                           expected.back().push_back(part);
+                         });
+  }
+
+  int mismatches = 0;
+  for (std::size_t i = 0; i < words.size(); ++i)
+  {
+    std::vector<dm::key_part> parts;
+    std::function<void(const dm::key_part*, std::size_t)> callback = [&parts](const dm::key_part* batch, std::size_t count)
+    {
+      parts.insert(parts.end(), batch, batch + count);
+    };
+    dm::double_metaphone_parts(words[i], callback);
+
+    std::string primary;
+    std::string alternate;
+    for (auto& part : parts)
+    {
+      primary += dm::part_symbols(part.code1);
+      alternate += dm::part_symbols(part.code2);
+    }
+    const auto keys = dm::double_metaphone(words[i]);
+    if (parts != expected[i] || primary != keys.first || alternate != keys.second)
+    {
+      std::clog << "Mismatched parts " << words[i] << "\n";
+      ++mismatches;
+    }
+  }
+
+  std::vector<std::vector<dm::key_part>> batched(words.size());
+  std::size_t next = 0;
+  dm::double_metaphone_parts(words.data(), words.size(),
+                             [&](std::size_t first, std::size_t count, const std::uint32_t* ends, const dm::key_part* parts)
+                             {
+                               if (first != next && first + 1 != next)
+                                 ++mismatches;
+                               for (std::size_t word = 0; word < count; ++word)
+                                 batched[first + word].insert(batched[first + word].end(), parts + (word ? ends[word - 1] : 0), parts + ends[word]);
+                               next = first + count;
+                             });
+  if (batched != expected || next != words.size())
+  {
+    std::clog << "Mismatched batched parts\n";
+    ++mismatches;
+  }
+  return mismatches;
+}
+
+int test_spans()
+{
+  std::vector<std::string> words;
+  for (auto& test : tests)
+    words.push_back(test[0]);
+  dm::key_spans spans;
+  dm::double_metaphone_spans(words.data(), words.size(), spans);
+
+  int mismatches = 0;
+  for (std::size_t i = 0; i < words.size(); ++i)
+  {
+    // each symbol spans the input of the callback producing it
+    std::vector<dm::source_span> expected1;
+    std::vector<dm::source_span> expected2;
+    dm::double_metaphone(words[i], [&](const char* metaph1, const char* metaph2, size_t start, size_t len)
+                         {
+                           for (std::size_t symbol = 0; metaph1 && metaph1[symbol]; ++symbol)
+                             expected1.push_back(dm::source_span { std::uint32_t(start), std::uint32_t(len) });
+                           for (std::size_t symbol = 0; metaph2 && metaph2[symbol]; ++symbol)
+                             expected2.push_back(dm::source_span { std::uint32_t(start), std::uint32_t(len) });
+                         });
+    const auto primary = spans.primary(i);
+    const auto alternate = spans.alternate(i);
+    if (std::string(primary.symbols, primary.size) != tests[i][1] || std::string(alternate.symbols, alternate.size) != tests[i][2]
+        || !std::equal(expected1.begin(), expected1.end(), primary.spans) || expected1.size() != primary.size
+        || !std::equal(expected2.begin(), expected2.end(), alternate.spans) || expected2.size() != alternate.size)
+    {
+      std::clog << "Mismatched spans " << words[i] << "\n";
+      ++mismatches;
+    }
+  }
+
+  // what the user typed against names, highlighting the letters whose symbols match
+  const char* matches[][4] = {
+    { "Barn", "Barnsley", "B rn", "B rn" },
+    { "Schmidt", "Smith", "m", "m" },
+    { "Xavier", "Zaviar", "X v", "Z v" }
+  };
+  for (auto& match : matches)
+  {
+    spans.clear();
+    spans.add(match[0]);
+    spans.add(match[1]);
+    std::vector<dm::source_span> spans1;
+    std::vector<dm::source_span> spans2;
+    dm::matching_spans(spans.primary(0), spans.primary(1), spans1, spans2);
+
+    std::string highlighted[2];
+    for (int word = 0; word < 2; ++word)
+      for (auto& span : word ? spans2 : spans1)
+        highlighted[word] += (highlighted[word].empty() ? "" : " ") + std::string(match[word]).substr(span.start, span.len);
+    if (highlighted[0] != match[2] || highlighted[1] != match[3])
+    {
+      std::clog << "Mismatched matching spans " << match[0] << " " << match[1] << "\n";
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+int test_interleaved()
+{
+  std::vector<std::string> words;
+  for (auto& test : tests)
+    words.push_back(test[0]);
+  words.push_back("");
+  words.push_back("GN");
+
+  int mismatches = 0;
+  std::vector<dm::packed_keys> keys(words.size());
+  dm::double_metaphone_packed_interleaved<3>(words.data(), words.size(), keys.data());
+
+  std::vector<std::pair<std::string, std::string>> results(words.size());
+  dm::double_metaphone_interleaved<8>(words.data(), words.size(),
+                                      [&results](std::size_t word, const char* metaph1, const char* metaph2, size_t start, size_t len)
+                                      {
+                                        results[word].first += metaph1 ? metaph1 : "";
+                                        results[word].second += metaph2 ? metaph2 : "";
+                                      });
+  for (std::size_t i = 0; i < words.size(); ++i)
+    if (keys[i] != dm::double_metaphone_packed(words[i]) || results[i] != dm::double_metaphone(words[i]))
+    {
+      std::clog << "Mismatched interleaved " << words[i] << "\n";
+      ++mismatches;
+    }
+  return mismatches;
+}
+
+int test_allocations()
+{
+  if (!dm::allocations_counted)
+    return 0;
+
+  // words short enough for the input copy and its padding to stay in the string's own buffer
+  std::vector<std::string> words;
+  for (auto& test : tests)
+    if (std::strlen(test[0]) <= 10)
+      words.push_back(test[0]);
+
+  auto index = make_test_index();
+  dm::dictionary dictionary(index.view());
+  dm::key_filter filter(index);
+  dm::packed_distance_pattern pattern(dm::pack_key("PRN"));
+  std::vector<dm::packed_keys> keys(words.size());
+
+  // APIs that must not allocate, and the allocations each made
+  std::vector<std::pair<const char*, std::uint64_t>> allocations;
+  auto expect_none = [&allocations](const char* api, std::function<void()> call)
+  {
+    const dm::allocation_scope scope;
+    call();
+    allocations.push_back(std::make_pair(api, scope.allocations()));
+  };
+
+  std::size_t sum = 0;
+  expect_none("callback", [&]()
+              {
+                for (auto& word : words)
+                  dm::double_metaphone(word, [&sum](const char*, const char*, size_t start, size_t) { sum += start; });
+              });
+  expect_none("packed", [&]()
+              {
+                for (std::size_t i = 0; i < words.size(); ++i)
+                  keys[i] = dm::double_metaphone_packed(words[i]);
+              });
+  expect_none("parts", [&]()
+              {
+                for (auto& word : words)
+                  dm::double_metaphone_parts(word, [&sum](const dm::key_part*, std::size_t count) { sum += count; });
+              });
+  expect_none("in place", [&]()
+              {
+                for (auto& word : words)
+                  dm::double_metaphone(word.data(), word.size(), [&sum](const char*, const char*, size_t start, size_t) { sum += start; });
+              });
+  expect_none("key pair", [&]()
+              {
+                for (auto& word : words)
+                  sum += dm::double_metaphone_key_pair(word).first_size();
+              });
+  expect_none("interleaved", [&]() { dm::double_metaphone_packed_interleaved<4>(words.data(), words.size(), keys.data()); });
+  expect_none("distance", [&]()
+              {
+                for (auto& key : keys)
+                  sum += pattern.distance(key.first, 2) + dm::packed_distance(key.first, key.second);
+              });
+  expect_none("lookup", [&]()
+              {
+                for (auto& key : keys)
+                  sum += index.lookup(key.first).size() + index.prefix_range(key.first, 2).second;
+              });
+  expect_none("dictionary", [&]()
+              {
+                for (auto& key : keys)
+                  sum += dictionary.select(dictionary.rank(key.first) % dictionary.size()) + dictionary.prefix_range(key.second, 2).first;
+              });
+  expect_none("filter", [&]()
+              {
+                for (auto& key : keys)
+                  sum += filter.may_contain(key);
+              });
+
+  int mismatches = 0;
+  for (auto& allocation : allocations)
+    if (allocation.second)
+    {
+      std::clog << "Mismatched allocations of " << allocation.first << ": " << allocation.second << " != 0\n";
+      ++mismatches;
+    }
+
+  // what allocating APIs cost, for the record
+  std::vector<std::string> all_words;
+  for (auto& test : tests)
+    all_words.push_back(test[0]);
+  for (auto pair : {false, true})
+  {
+    const dm::allocation_scope scope;
+    for (auto& word : all_words)
+      if (pair)
+        sum += dm::double_metaphone(word).first.size();
+      else
+        sum += dm::double_metaphone_packed(word).first;
+    std::clog << (pair ? "pair: " : "packed: ") << double(scope.allocations()) / all_words.size() << " allocations, "
+      << double(scope.bytes()) / all_words.size() << " bytes per word.\n";
+  }
+  return mismatches + (sum == 0);
+}
+
+int test_arena()
+{
+  std::vector<std::string> words;
+  for (auto& test : tests)
+    words.push_back(test[0]);
+
+  int mismatches = 0;
+  dm::arena memory(4096);
+  std::vector<dm::key_strings> keys(words.size());
+
+  // the input copies of long words allocate anyway
+  const dm::allocation_scope copies;
+  for (auto& word : words)
+    dm::double_metaphone(word, [](const char*, const char*, size_t, size_t) {});
+  const auto copied = copies.allocations();
+
+  // then a few blocks for all the keys and the scratch keys growing
+  const dm::allocation_scope scope;
+  dm::double_metaphone(words.data(), words.size(), keys.data(), memory);
+  if (scope.allocations() > copied + memory.blocks() + 8)
+  {
+    std::clog << "Mismatched arena allocations: " << scope.allocations() - copied << " for " << memory.blocks() << " blocks\n";
+    ++mismatches;
+  }
+
+  for (std::size_t i = 0; i < words.size(); ++i)
+  {
+    auto pair = dm::double_metaphone(words[i], memory);
+    if (std::strcmp(keys[i].first, tests[i][1]) != 0 || std::strcmp(keys[i].second, tests[i][2]) != 0
+        || pair.first != tests[i][1] || pair.second != tests[i][2])
+    {
+      std::clog << "Mismatched arena keys " << words[i] << "\n";
+      ++mismatches;
+    }
+  }
+
+  // allocations past a block, and alignment
+  const char* big = static_cast<const char*>(memory.allocate(10000));
+  const auto aligned = memory.allocate(8, 64);
+  if (!big || reinterpret_cast<std::uintptr_t>(aligned) % 64 != 0)
+    ++mismatches;
+  memory.release();
+  if (memory.blocks() != 0)
+    ++mismatches;
+  return mismatches;
+}
+
+int test_key_pair()
+{
+  int mismatches = 0;
+  std::vector<dm::key_pair> pairs;
+  for (auto& test : tests)
+  {
+    auto pair = dm::double_metaphone_key_pair(test[0]);
+    auto expected = dm::double_metaphone(test[0]);
+    if (expected.first.size() > dm::key_pair::capacity || expected.second.size() > dm::key_pair::capacity)
+    {
+      // truncated keys keep their prefix
+      if (!pair.overflowed() || expected.first.compare(0, pair.first_size(), pair.first()) != 0
+          || expected.second.compare(0, pair.second_size(), pair.second()) != 0)
+      {
+        std::clog << "Mismatched overflowed key pair " << test[0] << "\n";
+        ++mismatches;
+      }
+    }
+    else if (pair.overflowed() || pair.strings() != expected || pair.first() != expected.first || pair.second() != expected.second)
+    {
+      std::clog << "Mismatched key pair " << test[0] << ": " << pair.first() << " != " << test[1] << " || " << pair.second() << " != " << test[2] << "\n";
+      ++mismatches;
+    }
+    pairs.push_back(pair);
+  }
+
+  // long words overflow
+  auto long_pair = dm::double_metaphone_key_pair(std::string(40, 'B') + "ACKSTROKE" + std::string(40, 'T'));
+  if (!long_pair.overflowed() || long_pair.first_size() != dm::key_pair::capacity)
+    ++mismatches;
+
+  // comparison and hashing agree with the key strings
+  for (std::size_t i = 0; i < pairs.size(); ++i)
+  {
+    const std::size_t j = (i * 7 + 3) % pairs.size();
+    auto strings1 = pairs[i].strings();
+    auto strings2 = pairs[j].strings();
+    if (!pairs[i].overflowed() && !pairs[j].overflowed()
+        && ((pairs[i] == pairs[j]) != (strings1 == strings2) || (pairs[i] < pairs[j]) != (strings1 < strings2)))
+    {
+      std::clog << "Mismatched key pair comparison " << tests[i][0] << " " << tests[j][0] << "\n";
+      ++mismatches;
+    }
+    if (pairs[i] == pairs[j] && std::hash<dm::key_pair>()(pairs[i]) != std::hash<dm::key_pair>()(pairs[j]))
+      ++mismatches;
+  }
+  return mismatches;
+}
+
+int test_limits()
+{
+  int mismatches = 0;
+
+  // cuts fall back to the start of a UTF-8 character
+  const std::string munoz = "MU\xc3\x91OZ";
+  if (dm::utf8_prefix(munoz.data(), munoz.size(), 3) != 2 || dm::utf8_prefix(munoz.data(), munoz.size(), 4) != 4
+      || dm::utf8_prefix(munoz.data(), munoz.size(), 10) != munoz.size() || dm::utf8_prefix(munoz.data() + 2, 2, 1) != 0)
+    ++mismatches;
+
+  for (auto& test : tests)
+  {
+    const std::string word = test[0];
+    for (std::size_t max_length : { 0, 1, 3, 6 })
+    {
+      const auto limited = dm::double_metaphone(word, dm::encode_limits(max_length));
+      const auto truncated = dm::double_metaphone(word.substr(0, dm::utf8_prefix(word.data(), word.size(), max_length)));
+      if (limited != truncated)
+      {
+        std::clog << "Mismatched length limit " << max_length << " on " << word << ": " << limited.first << " != " << truncated.first << "\n";
+        ++mismatches;
+      }
+    }
+
+    // fewer steps give a prefix of the keys
+    const auto keys = dm::double_metaphone(word);
+    for (std::size_t max_steps : { 0, 1, 2, 4 })
+    {
+      std::size_t steps = 0;
+      dm::double_metaphone(word.data(), word.size(), [&steps](const char*, const char*, size_t, size_t) { ++steps; }, dm::encode_limits(-1, max_steps));
+      const auto limited = dm::double_metaphone(word, dm::encode_limits(-1, max_steps));
+      if (steps > max_steps + 2 || keys.first.compare(0, limited.first.size(), limited.first) != 0
+          || keys.second.compare(0, limited.second.size(), limited.second) != 0)
+      {
+        std::clog << "Mismatched step limit " << max_steps << " on " << word << "\n";
+        ++mismatches;
+      }
+    }
+  }
+
+  // every entry point taking a word takes its limits
+  {
+    const std::string word = "Kaczmarek-Witkowski";
+    const dm::encode_limits limits(9);
+    const auto expected = dm::double_metaphone(word.substr(0, 9));
+    std::pair<std::string, std::string> called;
+    dm::double_metaphone(word, [&called](const char* metaph1, const char* metaph2, size_t, size_t)
+                         {
+                           called.first += metaph1 ? metaph1 : "";
+                           called.second += metaph2 ? metaph2 : "";
+                         },
+                         limits);
+    std::size_t parts = 0;
+    dm::double_metaphone_parts(word, [&parts](const dm::key_part*, std::size_t count) { parts += count; }, limits);
+    std::size_t batched = 0;
+    dm::double_metaphone_parts(&word, 1, [&batched](std::size_t, std::size_t, const std::uint32_t* ends, const dm::key_part*) { batched += ends[0]; }, limits);
+    dm::key_spans spans;
+    spans.add(word, limits);
+    dm::double_metaphone_spans(&word, 1, spans, limits);
+    dm::arena memory;
+    const auto in_arena = dm::double_metaphone(word, memory, limits);
+    dm::key_strings strings;
+    dm::double_metaphone(&word, 1, &strings, memory, limits);
+    dm::packed_keys interleaved;
+    dm::double_metaphone_packed_interleaved(&word, 1, &interleaved, limits);
+    const auto expected_parts = [&]()
+    {
+      std::size_t count = 0;
+      dm::double_metaphone(word.substr(0, 9), [&count](const char*, const char*, size_t, size_t) { ++count; });
+      return count;
+    }();
+    if (called != expected || parts != expected_parts || batched != expected_parts
+        || spans.primary(0).size != expected.first.size() || spans.primary(1).size != expected.first.size()
+        || in_arena.first != expected.first.c_str() || strings.second != expected.second
+        || interleaved != dm::double_metaphone_packed(word.substr(0, 9)))
+    {
+      std::clog << "Mismatched limits of entry points\n";
+      ++mismatches;
+    }
+  }
+
+  // packing stops once both keys are full, with the same keys
+  std::string long_word;
+  while (long_word.size() < (1 << 20))
+    long_word += "Kaczmarek";
+  const auto long_keys = dm::double_metaphone(long_word);
+  if (dm::double_metaphone_packed(long_word) != dm::packed_keys(dm::pack_key(long_keys.first), dm::pack_key(long_keys.second)))
+    ++mismatches;
+
+  // and within limits, the work and memory don't grow with the word
+  if (dm::allocations_counted)
+  {
+    const dm::encode_limits limits(256, 256);
+    const dm::allocation_scope scope;
+    dm::double_metaphone(long_word.data(), long_word.size(), [](const char*, const char*, size_t, size_t) {}, limits);
+    dm::double_metaphone_packed(long_word, limits);
+    if (scope.bytes() > 2 * (256 + 8))
+    {
+      std::clog << "Mismatched limited allocations: " << scope.bytes() << " bytes\n";
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+int test_frames()
+{
+  int mismatches = 0;
+  std::string payload;
+  dm::detail::put(payload, std::uint32_t(2));
+  for (std::string word : {"Angier", "Smith"})
+  {
+    dm::detail::put(payload, std::uint32_t(word.size()));
+    payload += word;
+  }
+  const std::string framed = dm::make_frame(1, 42, payload) + dm::make_frame(3, 43, "");
+
+  // fed a byte at a time, frames come out whole once complete
+  std::string input;
+  std::vector<dm::request_frame> frames;
+  for (std::size_t i = 0; i < framed.size(); ++i)
+  {
+    input += framed[i];
+    if (!dm::take_frames(input, frames))
+      ++mismatches;
+  }
+  std::vector<std::string> words;
+  if (frames.size() != 2 || !input.empty() || frames[0].type != 1 || frames[0].tag != 42 || frames[1].type != 3 || frames[1].tag != 43
+      || !frames[1].payload.empty() || !dm::frame_words(frames[0].payload, words) || words != std::vector<std::string> { "Angier", "Smith" })
+  {
+    std::clog << "Mismatched frames\n";
+    ++mismatches;
+  }
+
+  // payloads that don't add up are rejected
+  words.clear();
+  if (dm::frame_words(payload.substr(0, payload.size() - 1), words) || dm::frame_words(payload + "x", words) || dm::frame_words("", words))
+    ++mismatches;
+
+  // frames too short for their type and tag, or announcing more than the maximum, are rejected before their payload arrives
+  std::string malformed;
+  dm::detail::put(malformed, std::uint32_t(4));
+  malformed += "abcd";
+  std::string oversized;
+  dm::detail::put(oversized, std::uint32_t(dm::max_frame_size + 1));
+  std::string huge;
+  dm::detail::put(huge, std::uint32_t(0xFFFFFFFF));
+  for (auto bad : {malformed, oversized, huge, dm::make_frame(1, 0, "") + malformed})
+  {
+    frames.clear();
+    if (dm::take_frames(bad, frames))
+    {
+      std::clog << "Mismatched bad frame of " << bad.size() << " bytes\n";
+      ++mismatches;
+    }
+  }
+  input = dm::make_frame(1, 0, std::string(100, 'x'));
+  frames.clear();
+  if (dm::take_frames(input, frames, 50) || !frames.empty())
+    ++mismatches;
+  return mismatches;
+}
+
+int test_mapped_index()
+{
+  char path[] = "/tmp/dm_index_XXXXXX";
+  const int file = ::mkstemp(path);
+  if (file < 0)
+    return 1;
+  ::close(file);
+
+  int mismatches = 0;
+  const auto index = make_test_index();
+  dm::write_index(index.view(), path);
+  {
+    const dm::mapped_index mapped(path);
+    const auto view = mapped.view();
+    if (view.size() != index.size())
+      ++mismatches;
+    for (auto& test : tests)
+      for (auto key : {test[1], test[2]})
+      {
+        const auto expected = index.lookup(dm::pack_key(key));
+        const auto ids = view.lookup(dm::pack_key(key));
+        if (ids.size() != expected.size() || !std::equal(expected.begin(), expected.end(), ids.begin()))
+        {
+          std::clog << "Mismatched mapped lookup " << test[0] << " " << key << "\n";
+          ++mismatches;
+        }
+      }
+  }
+
+  std::string written;
+  {
+    std::ifstream in(path, std::ios::binary);
+    written.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  const std::size_t offsets_start = sizeof(dm::index_file_header) + index.size() * sizeof(dm::packed_key);
+  auto with_offset = [&](std::size_t i, std::uint32_t offset)
+  {
+    std::string changed = written;
+    std::memcpy(&changed[offsets_start + i * sizeof(offset)], &offset, sizeof(offset));
+    return changed;
+  };
+
+  // a header whose sizes wrap around to the file size
+  dm::index_file_header wrapping;
+  std::memcpy(&wrapping, written.data(), sizeof(wrapping));
+  wrapping.keys = std::uint64_t(1) << 62;
+  wrapping.ids = 2;
+  std::string wrapped(reinterpret_cast<const char*>(&wrapping), sizeof(wrapping));
+  wrapped.append(sizeof(std::uint32_t) + 2 * sizeof(dm::record_id), '\0');
+
+  std::string bad_magic = written;
+  bad_magic[0] = 'X';
+  std::uint32_t second;
+  std::memcpy(&second, &written[offsets_start + sizeof(second)], sizeof(second));
+  for (auto corrupt : {written.substr(0, written.size() - 1), written.substr(0, 10), bad_magic, wrapped,
+    with_offset(0, 1), with_offset(index.size(), std::uint32_t(index.ids().size() - 1)), with_offset(1, second + 1000000)})
+  {
+    {
+      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+      out.write(corrupt.data(), std::streamsize(corrupt.size()));
+    }
+    try
+    {
+      dm::mapped_index mapped(path);
+      std::clog << "Mismatched corrupt index of " << corrupt.size() << " bytes\n";
+      ++mismatches;
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+  }
+  ::unlink(path);
+  return mismatches;
+}
 
 int main()
 {
@@ -1252,4 +1361,29 @@ int main()
   }
 
   std::clog << matches << " matches, " << mismatches << " mismatches.\n";
+
+  mismatches += test_packed();
+  mismatches += test_scan();
+  mismatches += test_distance();
+  mismatches += test_lookup();
+  mismatches += test_deletion_index();
+  mismatches += test_join();
+  mismatches += test_sort();
+  mismatches += test_filter();
+  mismatches += test_live_index();
+  mismatches += test_postings();
+  mismatches += test_dictionary();
+  mismatches += test_prefix();
+  mismatches += test_composite();
+  mismatches += test_parts();
+  mismatches += test_spans();
+  mismatches += test_interleaved();
+  mismatches += test_allocations();
+  mismatches += test_arena();
+  mismatches += test_key_pair();
+  mismatches += test_limits();
+  mismatches += test_frames();
+  mismatches += test_mapped_index();
+  std::clog << mismatches << " mismatches in total.\n";
+  return mismatches != 0;
 }
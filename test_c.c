@@ -0,0 +1,209 @@
+//
+//  test_c.c
+//
+//  Tests the C interface of libdmetaphone, at every micro-architecture level the machine runs.
+//
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "double_metaphone_c.h"
+
+static const char* tests[][3] =
+{
+  {"Angier", "ANJ", "ANJR"},
+  {"Bachelor", "PXLR", "PKLR"},
+  {"Filipowicz", "FLPTS", "FLPFX"},
+  {"smith", "SM0", "XMT"},
+  {"Xavier", "SF", "SFR"},
+  {"", "", ""},
+  {"\xc3\x87" "elik", "SLK", "SLK"},
+  {"Iru\xc3\xb1" "a", "ARN", "ARN"}
+};
+
+#define TEST_COUNT (sizeof(tests) / sizeof(tests[0]))
+
+static int test_encode(void)
+{
+  int mismatches = 0;
+  size_t i;
+
+  for (i = 0; i < TEST_COUNT; ++i)
+  {
+    char primary[32];
+    char alternate[32];
+    size_t primary_length;
+    size_t alternate_length;
+    int status = dm_double_metaphone(tests[i][0], strlen(tests[i][0]),
+                                     primary, sizeof(primary), &primary_length,
+                                     alternate, sizeof(alternate), &alternate_length);
+    if (status != DM_OK || strcmp(primary, tests[i][1]) != 0 || strcmp(alternate, tests[i][2]) != 0
+        || primary_length != strlen(tests[i][1]))
+    {
+      fprintf(stderr, "Mismatched %s: %s != %s || %s != %s\n", tests[i][0], primary, tests[i][1], alternate, tests[i][2]);
+      ++mismatches;
+    }
+
+    /* too small still reports the length */
+    status = dm_double_metaphone(tests[i][0], strlen(tests[i][0]),
+                                 primary, 2, &primary_length,
+                                 alternate, sizeof(alternate), &alternate_length);
+    if ((status == DM_TRUNCATED) != (strlen(tests[i][1]) > 1) || primary_length != strlen(tests[i][1]))
+    {
+      fprintf(stderr, "Mismatched truncated %s\n", tests[i][0]);
+      ++mismatches;
+    }
+  }
+
+  {
+    uint64_t offsets[TEST_COUNT + 1];
+    char bytes[256];
+    uint64_t primary_offsets[TEST_COUNT + 1];
+    uint64_t alternate_offsets[TEST_COUNT + 1];
+    char primary_bytes[512];
+    char alternate_bytes[512];
+    uint64_t primary_packed[TEST_COUNT];
+    uint64_t alternate_packed[TEST_COUNT];
+    size_t done;
+    int status;
+
+    offsets[0] = 0;
+    for (i = 0; i < TEST_COUNT; ++i)
+    {
+      memcpy(bytes + offsets[i], tests[i][0], strlen(tests[i][0]));
+      offsets[i + 1] = offsets[i] + strlen(tests[i][0]);
+    }
+
+    status = dm_double_metaphone_batch(TEST_COUNT, offsets, bytes,
+                                       primary_offsets, primary_bytes, sizeof(primary_bytes),
+                                       alternate_offsets, alternate_bytes, sizeof(alternate_bytes),
+                                       &done);
+    dm_double_metaphone_packed_batch(TEST_COUNT, offsets, bytes, primary_packed, alternate_packed);
+    for (i = 0; i < TEST_COUNT; ++i)
+    {
+      uint64_t primary;
+      uint64_t alternate;
+      dm_double_metaphone_packed(tests[i][0], strlen(tests[i][0]), &primary, &alternate);
+      if (status != DM_OK || done != TEST_COUNT
+          || primary_offsets[i + 1] - primary_offsets[i] != strlen(tests[i][1])
+          || memcmp(primary_bytes + primary_offsets[i], tests[i][1], strlen(tests[i][1])) != 0
+          || alternate_offsets[i + 1] - alternate_offsets[i] != strlen(tests[i][2])
+          || memcmp(alternate_bytes + alternate_offsets[i], tests[i][2], strlen(tests[i][2])) != 0
+          || primary_packed[i] != primary || alternate_packed[i] != alternate)
+      {
+        fprintf(stderr, "Mismatched batch %s\n", tests[i][0]);
+        ++mismatches;
+      }
+    }
+
+    /* resumes where a small buffer ran out */
+    status = dm_double_metaphone_batch(TEST_COUNT, offsets, bytes,
+                                       primary_offsets, primary_bytes, 8,
+                                       alternate_offsets, alternate_bytes, sizeof(alternate_bytes),
+                                       &done);
+    if (status != DM_TRUNCATED || done != 2 || primary_offsets[done] != 7)
+    {
+      fprintf(stderr, "Mismatched truncated batch after %zu\n", done);
+      ++mismatches;
+    }
+  }
+
+  return mismatches;
+}
+
+/* every entry point cut to the limits, as if given the first bytes of the word */
+static int test_limits(void)
+{
+  int mismatches = 0;
+  const char word[] = "Kaczmarek-Witkowski";
+  const uint64_t offsets[2] = { 0, sizeof(word) - 1 };
+  char primary[32];
+  char alternate[32];
+  char cut_primary[32];
+  char cut_alternate[32];
+  size_t primary_length;
+  size_t alternate_length;
+  uint64_t primary_offsets[2];
+  uint64_t alternate_offsets[2];
+  char primary_bytes[32];
+  char alternate_bytes[32];
+  uint64_t packed_primary;
+  uint64_t packed_alternate;
+  uint64_t batch_primary;
+  uint64_t batch_alternate;
+  uint64_t cut_packed_primary;
+  uint64_t cut_packed_alternate;
+  size_t length;
+  size_t steps;
+  size_t done;
+
+  dm_limits(&length, &steps);
+  if (length != SIZE_MAX || steps != SIZE_MAX)
+  {
+    fprintf(stderr, "Mismatched default limits %zu %zu\n", length, steps);
+    ++mismatches;
+  }
+
+  dm_double_metaphone(word, 9, cut_primary, sizeof(cut_primary), &primary_length,
+                      cut_alternate, sizeof(cut_alternate), &alternate_length);
+  dm_double_metaphone_packed(word, 9, &cut_packed_primary, &cut_packed_alternate);
+
+  dm_set_limits(9, SIZE_MAX);
+  dm_limits(&length, &steps);
+  dm_double_metaphone(word, sizeof(word) - 1, primary, sizeof(primary), &primary_length,
+                      alternate, sizeof(alternate), &alternate_length);
+  dm_double_metaphone_packed(word, sizeof(word) - 1, &packed_primary, &packed_alternate);
+  dm_double_metaphone_packed_batch(1, offsets, word, &batch_primary, &batch_alternate);
+  dm_double_metaphone_batch(1, offsets, word, primary_offsets, primary_bytes, sizeof(primary_bytes),
+                            alternate_offsets, alternate_bytes, sizeof(alternate_bytes), &done);
+  if (length != 9 || steps != SIZE_MAX
+      || strcmp(primary, cut_primary) != 0 || strcmp(alternate, cut_alternate) != 0
+      || packed_primary != cut_packed_primary || packed_alternate != cut_packed_alternate
+      || batch_primary != cut_packed_primary || batch_alternate != cut_packed_alternate
+      || done != 1 || primary_offsets[1] != strlen(cut_primary) || memcmp(primary_bytes, cut_primary, strlen(cut_primary)) != 0
+      || alternate_offsets[1] != strlen(cut_alternate) || memcmp(alternate_bytes, cut_alternate, strlen(cut_alternate)) != 0)
+  {
+    fprintf(stderr, "Mismatched limited %s: %s %s\n", word, primary, alternate);
+    ++mismatches;
+  }
+  dm_set_limits(SIZE_MAX, SIZE_MAX);
+  return mismatches;
+}
+
+int main(void)
+{
+  int mismatches = 0;
+  int arch;
+  int best;
+  int level;
+
+  if (dm_abi_version() != DM_ABI_VERSION)
+  {
+    fprintf(stderr, "Mismatched ABI version %d\n", dm_abi_version());
+    ++mismatches;
+  }
+
+  /* the environment lowers the level chosen on first use */
+  setenv("DM_ARCH", "x86-64-v2", 1);
+  arch = dm_arch();
+  best = dm_set_arch(DM_ARCH_X86_64_V4);
+  if (arch != (best < DM_ARCH_X86_64_V2 ? best : DM_ARCH_X86_64_V2))
+  {
+    fprintf(stderr, "Mismatched DM_ARCH level %d\n", arch);
+    ++mismatches;
+  }
+
+  for (level = DM_ARCH_BASELINE; level <= DM_ARCH_X86_64_V4; ++level)
+    if (dm_set_arch(level) == level && dm_arch() == level)
+      mismatches += test_encode();
+    else
+      fprintf(stderr, "Skipped level %d, not supported here.\n", level);
+
+  mismatches += test_limits();
+
+  fprintf(stderr, "%d mismatches.\n", mismatches);
+  return mismatches != 0;
+}
@@ -0,0 +1,35 @@
+-- test_sqlite.sql
+--
+-- Tests the SQLite extension, printing mismatches.
+
+.load ./dmetaphone
+
+SELECT 'Mismatched dmetaphone' WHERE dmetaphone('Smith') != 'SM0' OR dmetaphone_alt('Smith') != 'XMT';
+SELECT 'Mismatched dmetaphone of null' WHERE dmetaphone(NULL) IS NOT NULL;
+SELECT 'Mismatched dmetaphone_key' WHERE dmetaphone_key('Schmidt') != dmetaphone_alt_key('Smith');
+SELECT 'Mismatched sounds_like' WHERE NOT sounds_like('Smith', 'Schmidt') OR sounds_like('Smith', 'Jones');
+
+CREATE VIRTUAL TABLE people USING dmetaphone;
+INSERT INTO people(rowid, name) VALUES (1, 'Smith'), (2, 'Schmidt'), (3, 'Jones'), (4, 'Smyth'), (5, NULL);
+INSERT INTO people(name) VALUES ('Barnes');
+
+SELECT 'Mismatched people' WHERE (SELECT group_concat(rowid) FROM (SELECT rowid FROM people WHERE sounds_like(name, 'Smith') ORDER BY rowid)) != '1,2,4';
+SELECT 'Mismatched keys' WHERE (SELECT primary_key || '/' || alternate_key FROM people WHERE rowid = 2) != 'XMT/SMT';
+
+UPDATE people SET name = 'Jonas' WHERE rowid = 2;
+DELETE FROM people WHERE rowid = 4;
+SELECT 'Mismatched update' WHERE (SELECT group_concat(rowid) FROM (SELECT rowid FROM people WHERE sounds_like(name, 'Smith') ORDER BY rowid)) != '1';
+SELECT 'Mismatched update of keys' WHERE (SELECT count(*) FROM people_keys) != 7;
+SELECT 'Mismatched join' WHERE (SELECT count(*) FROM people a, people b WHERE sounds_like(b.name, a.name)) != 6;
+
+EXPLAIN QUERY PLAN SELECT rowid FROM people WHERE sounds_like(name, 'Smith');
+
+DROP TABLE people;
+
+CREATE VIRTUAL TABLE "o""brien" USING dmetaphone;
+INSERT INTO "o""brien"(rowid, name) VALUES (1, 'Smith'), (2, 'Jones');
+SELECT 'Mismatched quoted name' WHERE (SELECT group_concat(rowid) FROM "o""brien" WHERE sounds_like(name, 'Smyth')) != '1';
+SELECT 'Mismatched quoted keys' WHERE (SELECT count(*) FROM "o""brien_keys") != 4;
+DROP TABLE "o""brien";
+
+SELECT 'done';